@@ -0,0 +1,122 @@
+#include "bench.hpp"
+
+#include "stream_of.hpp"
+#include "executor.hpp"
+#include "channel.hpp"
+#include "collectors/vector_collector.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <thread>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+using namespace exstream;
+using namespace exstream::bench;
+
+// NOTE: both sides spend similar time per element, so the async boundary can overlap them on two cores
+static uint32_t spin(uint32_t value) noexcept
+{
+    for (int i = 0; i < 64; ++i)
+        value = value * 1664525u + 1013904223u;
+
+    return value;
+}
+
+template <typename T>
+static void map_foreach_stream(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        uint32_t sum = 0;
+        stream_of(input)
+            .map([](const T& value) { return spin(uint32_t(key_of(value))); })
+            .foreach([&](const uint32_t value) { sum += spin(value); });
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <typename T>
+static void map_async_foreach_stream(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        uint32_t sum = 0;
+        stream_of(input)
+            .map([](const T& value) { return spin(uint32_t(key_of(value))); })
+            .async(thread_executor())
+            .foreach([&](const uint32_t value) { sum += spin(value); });
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <typename T>
+static void par_map_foreach_stream(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+    const thread_pool pool;
+
+    run(state, [&]
+    {
+        uint32_t sum = 0;
+        stream_of(input)
+            .par_map([](const T& value) { return spin(uint32_t(key_of(value))); }, pool)
+            .foreach([&](const uint32_t value) { sum += spin(value); });
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+// NOTE: the producer thread buffers all its results before the consumer starts
+template <typename T>
+static void map_buffer_foreach_stream(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        std::vector<uint32_t> buffer;
+        std::thread producer([&]
+        {
+            buffer = stream_of(input)
+                .map([](const T& value) { return spin(uint32_t(key_of(value))); })
+                .collect(to_vector());
+        });
+        producer.join();
+
+        uint32_t sum = 0;
+        stream_of(buffer).foreach([&](const uint32_t value) { sum += spin(value); });
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <typename T>
+static void map_channel_foreach_stream(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        channel<uint32_t> queue(1024);
+        std::thread producer([&]
+        {
+            stream_of(input)
+                .map([](const T& value) { return spin(uint32_t(key_of(value))); })
+                .collect(to_channel(queue));
+            queue.close();
+        });
+
+        uint32_t sum = 0;
+        stream_of(queue).foreach([&](const uint32_t value) { sum += spin(value); });
+        producer.join();
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+EXSTREAM_BENCHMARK(map_foreach_stream);
+EXSTREAM_BENCHMARK(map_async_foreach_stream);
+EXSTREAM_BENCHMARK(par_map_foreach_stream);
+EXSTREAM_BENCHMARK(map_buffer_foreach_stream);
+EXSTREAM_BENCHMARK(map_channel_foreach_stream);
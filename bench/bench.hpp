@@ -0,0 +1,137 @@
+#pragma once
+
+#include "config.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+// NOTE: every benchmark registered through EXSTREAM_BENCHMARK runs for int and 16, 64 and 256 bytes records
+#define EXSTREAM_BENCHMARK(function)\
+    BENCHMARK_TEMPLATE(function, int)->Apply(::exstream::bench::apply_sizes<int>);\
+    BENCHMARK_TEMPLATE(function, ::exstream::bench::record<16>)->Apply(::exstream::bench::apply_sizes<::exstream::bench::record<16>>);\
+    BENCHMARK_TEMPLATE(function, ::exstream::bench::record<64>)->Apply(::exstream::bench::apply_sizes<::exstream::bench::record<64>>);\
+    BENCHMARK_TEMPLATE(function, ::exstream::bench::record<256>)->Apply(::exstream::bench::apply_sizes<::exstream::bench::record<256>>)
+
+namespace exstream {
+namespace bench {
+
+constexpr size_t min_elements_count = 16;
+constexpr size_t max_elements_count = 100000000;
+constexpr size_t elements_count_multiplier = 16;
+
+// NOTE: inputs larger than this are skipped, 100M of 256 bytes records doesn't fit into memory of an ordinary machine
+constexpr size_t max_input_bytes = size_t(1) << 30;
+
+// NOTE: defined in main.cpp together with the global operator new replacement
+size_t allocations_count() noexcept;
+
+template <size_t Size>
+struct record final
+{
+    static_assert(Size > sizeof(int32_t), "Record is too small");
+
+    explicit record(const int32_t key) noexcept
+        : key(key),
+          payload()
+    {
+    }
+
+    bool operator== (const record& that) const noexcept
+    {
+        return key == that.key;
+    }
+
+    bool operator!= (const record& that) const noexcept
+    {
+        return key != that.key;
+    }
+
+    bool operator< (const record& that) const noexcept
+    {
+        return key < that.key;
+    }
+
+    int32_t key;
+    std::array<char, Size - sizeof(int32_t)> payload;
+};
+
+inline int32_t key_of(const int value) noexcept
+{
+    return value;
+}
+
+template <size_t Size>
+int32_t key_of(const record<Size>& value) noexcept
+{
+    return value.key;
+}
+
+// NOTE: keys are repeated roughly twice, so distinct and set based collectors drop a half of the input
+template <typename T>
+std::vector<T> make_input(const size_t count)
+{
+    std::vector<T> input;
+    input.reserve(count);
+
+    uint32_t seed = 42;
+    const auto keysCount = uint32_t(count / 2 + 1);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        input.emplace_back(int32_t(seed % keysCount));
+    }
+
+    return input;
+}
+
+template <typename T>
+void apply_sizes(benchmark::internal::Benchmark* benchmark)
+{
+    for (size_t count = min_elements_count; count <= max_elements_count; count *= elements_count_multiplier)
+    {
+        if (count * sizeof(T) <= max_input_bytes)
+            benchmark->Arg(int64_t(count));
+    }
+
+    if (max_elements_count * sizeof(T) <= max_input_bytes)
+        benchmark->Arg(int64_t(max_elements_count));
+}
+
+// NOTE: runs the function once per iteration and reports time and heap allocations per input element
+template <typename Function>
+void run(benchmark::State& state, Function&& function)
+{
+    const auto count = size_t(state.range(0));
+    const auto allocationsBefore = allocations_count();
+
+    for (auto _ : state)
+        function();
+
+    const auto allocations = allocations_count() - allocationsBefore;
+    const auto elements = double(count) * double(state.iterations());
+
+    state.SetItemsProcessed(int64_t(elements));
+    state.counters["time/element"] = benchmark::Counter(elements, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state.counters["allocs/element"] = benchmark::Counter(double(allocations) / elements);
+}
+
+}} // exstream::bench namespace
+
+namespace std {
+
+template <size_t Size>
+struct hash<exstream::bench::record<Size>>
+{
+    size_t operator() (const exstream::bench::record<Size>& value) const noexcept
+    {
+        return std::hash<int32_t>()(value.key);
+    }
+};
+
+} // std namespace
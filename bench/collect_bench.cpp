@@ -0,0 +1,428 @@
+#include "bench.hpp"
+
+#include "stream_of.hpp"
+#include "collectors/collectors.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <map>
+#include <queue>
+#include <set>
+#include <stack>
+#include <unordered_map>
+#include <unordered_set>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+using namespace exstream;
+using namespace exstream::bench;
+
+template <typename T, typename Function>
+static void collect_loop(benchmark::State& state, const Function& function)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        auto result = function(input);
+        benchmark::DoNotOptimize(result);
+    });
+}
+
+template <typename T, typename MakeCollector>
+static void collect_stream(benchmark::State& state, const MakeCollector& makeCollector)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        auto result = stream_of(input).collect(makeCollector());
+        benchmark::DoNotOptimize(result);
+    });
+}
+
+template <typename T, typename MakeCollector>
+static void collect_entries_stream(benchmark::State& state, const MakeCollector& makeCollector)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        auto result = stream_of(input)
+            .map([](const T& value) { return std::make_pair(key_of(value), value); })
+            .collect(makeCollector());
+
+        benchmark::DoNotOptimize(result);
+    });
+}
+
+template <typename T>
+static void to_vector_loop(benchmark::State& state)
+{
+    collect_loop<T>(state, [](const std::vector<T>& input)
+    {
+        std::vector<T> result;
+        result.reserve(input.size());
+
+        for (const auto& value : input)
+            result.push_back(value);
+
+        return result;
+    });
+}
+
+template <typename T>
+static void to_vector_stream(benchmark::State& state)
+{
+    collect_stream<T>(state, [] { return to_vector(); });
+}
+
+template <typename T>
+static void to_small_vector_stream(benchmark::State& state)
+{
+    collect_stream<T>(state, [] { return to_small_vector<16>(); });
+}
+
+template <typename T>
+static void to_deque_loop(benchmark::State& state)
+{
+    collect_loop<T>(state, [](const std::vector<T>& input)
+    {
+        std::deque<T> result;
+        for (const auto& value : input)
+            result.push_back(value);
+
+        return result;
+    });
+}
+
+template <typename T>
+static void to_deque_stream(benchmark::State& state)
+{
+    collect_stream<T>(state, [] { return to_deque(); });
+}
+
+template <typename T>
+static void to_list_loop(benchmark::State& state)
+{
+    collect_loop<T>(state, [](const std::vector<T>& input)
+    {
+        std::list<T> result;
+        for (const auto& value : input)
+            result.push_back(value);
+
+        return result;
+    });
+}
+
+template <typename T>
+static void to_list_stream(benchmark::State& state)
+{
+    collect_stream<T>(state, [] { return to_list(); });
+}
+
+template <typename T>
+static void to_forward_list_loop(benchmark::State& state)
+{
+    collect_loop<T>(state, [](const std::vector<T>& input)
+    {
+        std::forward_list<T> result;
+        auto last = result.before_begin();
+
+        for (const auto& value : input)
+            last = result.insert_after(last, value);
+
+        return result;
+    });
+}
+
+template <typename T>
+static void to_forward_list_stream(benchmark::State& state)
+{
+    collect_stream<T>(state, [] { return to_forward_list(); });
+}
+
+template <typename T>
+static void to_stack_loop(benchmark::State& state)
+{
+    collect_loop<T>(state, [](const std::vector<T>& input)
+    {
+        std::stack<T> result;
+        for (const auto& value : input)
+            result.push(value);
+
+        return result;
+    });
+}
+
+template <typename T>
+static void to_stack_stream(benchmark::State& state)
+{
+    collect_stream<T>(state, [] { return to_stack(); });
+}
+
+template <typename T>
+static void to_queue_loop(benchmark::State& state)
+{
+    collect_loop<T>(state, [](const std::vector<T>& input)
+    {
+        std::queue<T> result;
+        for (const auto& value : input)
+            result.push(value);
+
+        return result;
+    });
+}
+
+template <typename T>
+static void to_queue_stream(benchmark::State& state)
+{
+    collect_stream<T>(state, [] { return to_queue(); });
+}
+
+template <typename T>
+static void to_priority_queue_loop(benchmark::State& state)
+{
+    collect_loop<T>(state, [](const std::vector<T>& input)
+    {
+        std::priority_queue<T> result;
+        for (const auto& value : input)
+            result.push(value);
+
+        return result;
+    });
+}
+
+template <typename T>
+static void to_priority_queue_stream(benchmark::State& state)
+{
+    collect_stream<T>(state, [] { return to_priority_queue(); });
+}
+
+template <typename T>
+static void to_set_loop(benchmark::State& state)
+{
+    collect_loop<T>(state, [](const std::vector<T>& input)
+    {
+        return std::set<T>(std::begin(input), std::end(input));
+    });
+}
+
+template <typename T>
+static void to_set_stream(benchmark::State& state)
+{
+    collect_stream<T>(state, [] { return to_set(); });
+}
+
+template <typename T>
+static void to_multiset_loop(benchmark::State& state)
+{
+    collect_loop<T>(state, [](const std::vector<T>& input)
+    {
+        return std::multiset<T>(std::begin(input), std::end(input));
+    });
+}
+
+template <typename T>
+static void to_multiset_stream(benchmark::State& state)
+{
+    collect_stream<T>(state, [] { return to_multiset(); });
+}
+
+template <typename T>
+static void to_unordered_set_loop(benchmark::State& state)
+{
+    collect_loop<T>(state, [](const std::vector<T>& input)
+    {
+        std::unordered_set<T> result;
+        result.reserve(input.size());
+
+        for (const auto& value : input)
+            result.insert(value);
+
+        return result;
+    });
+}
+
+template <typename T>
+static void to_unordered_set_stream(benchmark::State& state)
+{
+    collect_stream<T>(state, [] { return to_unordered_set(); });
+}
+
+template <typename T>
+static void to_unordered_multiset_loop(benchmark::State& state)
+{
+    collect_loop<T>(state, [](const std::vector<T>& input)
+    {
+        std::unordered_multiset<T> result;
+        result.reserve(input.size());
+
+        for (const auto& value : input)
+            result.insert(value);
+
+        return result;
+    });
+}
+
+template <typename T>
+static void to_unordered_multiset_stream(benchmark::State& state)
+{
+    collect_stream<T>(state, [] { return to_unordered_multiset(); });
+}
+
+template <typename T>
+static void to_map_loop(benchmark::State& state)
+{
+    collect_loop<T>(state, [](const std::vector<T>& input)
+    {
+        std::map<int32_t, T> result;
+        for (const auto& value : input)
+            result.insert(std::make_pair(key_of(value), value));
+
+        return result;
+    });
+}
+
+template <typename T>
+static void to_map_stream(benchmark::State& state)
+{
+    collect_entries_stream<T>(state, [] { return to_map(); });
+}
+
+template <typename T>
+static void to_multimap_loop(benchmark::State& state)
+{
+    collect_loop<T>(state, [](const std::vector<T>& input)
+    {
+        std::multimap<int32_t, T> result;
+        for (const auto& value : input)
+            result.insert(std::make_pair(key_of(value), value));
+
+        return result;
+    });
+}
+
+template <typename T>
+static void to_multimap_stream(benchmark::State& state)
+{
+    collect_entries_stream<T>(state, [] { return to_multimap(); });
+}
+
+template <typename T>
+static void to_unordered_map_loop(benchmark::State& state)
+{
+    collect_loop<T>(state, [](const std::vector<T>& input)
+    {
+        std::unordered_map<int32_t, T> result;
+        result.reserve(input.size());
+
+        for (const auto& value : input)
+            result.insert(std::make_pair(key_of(value), value));
+
+        return result;
+    });
+}
+
+template <typename T>
+static void to_unordered_map_stream(benchmark::State& state)
+{
+    collect_entries_stream<T>(state, [] { return to_unordered_map(); });
+}
+
+template <typename T>
+static void to_unordered_multimap_loop(benchmark::State& state)
+{
+    collect_loop<T>(state, [](const std::vector<T>& input)
+    {
+        std::unordered_multimap<int32_t, T> result;
+        result.reserve(input.size());
+
+        for (const auto& value : input)
+            result.insert(std::make_pair(key_of(value), value));
+
+        return result;
+    });
+}
+
+template <typename T>
+static void to_unordered_multimap_stream(benchmark::State& state)
+{
+    collect_entries_stream<T>(state, [] { return to_unordered_multimap(); });
+}
+
+// NOTE: the input is collected by 16 chunk builders which are combined into the first one
+template <typename T, typename Combine>
+static void combine_chunks(benchmark::State& state, const Combine& combine)
+{
+    constexpr size_t chunks = 16;
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        using builder_t = decltype(to_vector().builder(type_t<T>()));
+
+        std::vector<builder_t> builders(chunks);
+        for (size_t i = 0; i < input.size(); ++i)
+            builders[i * chunks / input.size()].append(input[i]);
+
+        combine(builders.front(), std::next(builders.begin()), builders.end());
+
+        auto result = builders.front().build();
+        benchmark::DoNotOptimize(result);
+    });
+}
+
+template <typename T>
+static void combine_vector_fold(benchmark::State& state)
+{
+    combine_chunks<T>(state, [](auto& builder, auto first, auto last)
+    {
+        for (; first != last; ++first)
+            builder.combine(std::move(*first));
+    });
+}
+
+template <typename T>
+static void combine_vector_range(benchmark::State& state)
+{
+    combine_chunks<T>(state, [](auto& builder, auto first, auto last)
+    {
+        builder.combine(first, last);
+    });
+}
+
+EXSTREAM_BENCHMARK(to_vector_loop);
+EXSTREAM_BENCHMARK(to_vector_stream);
+EXSTREAM_BENCHMARK(to_small_vector_stream);
+EXSTREAM_BENCHMARK(to_deque_loop);
+EXSTREAM_BENCHMARK(to_deque_stream);
+EXSTREAM_BENCHMARK(to_list_loop);
+EXSTREAM_BENCHMARK(to_list_stream);
+EXSTREAM_BENCHMARK(to_forward_list_loop);
+EXSTREAM_BENCHMARK(to_forward_list_stream);
+EXSTREAM_BENCHMARK(to_stack_loop);
+EXSTREAM_BENCHMARK(to_stack_stream);
+EXSTREAM_BENCHMARK(to_queue_loop);
+EXSTREAM_BENCHMARK(to_queue_stream);
+EXSTREAM_BENCHMARK(to_priority_queue_loop);
+EXSTREAM_BENCHMARK(to_priority_queue_stream);
+EXSTREAM_BENCHMARK(to_set_loop);
+EXSTREAM_BENCHMARK(to_set_stream);
+EXSTREAM_BENCHMARK(to_multiset_loop);
+EXSTREAM_BENCHMARK(to_multiset_stream);
+EXSTREAM_BENCHMARK(to_unordered_set_loop);
+EXSTREAM_BENCHMARK(to_unordered_set_stream);
+EXSTREAM_BENCHMARK(to_unordered_multiset_loop);
+EXSTREAM_BENCHMARK(to_unordered_multiset_stream);
+EXSTREAM_BENCHMARK(to_map_loop);
+EXSTREAM_BENCHMARK(to_map_stream);
+EXSTREAM_BENCHMARK(to_multimap_loop);
+EXSTREAM_BENCHMARK(to_multimap_stream);
+EXSTREAM_BENCHMARK(to_unordered_map_loop);
+EXSTREAM_BENCHMARK(to_unordered_map_stream);
+EXSTREAM_BENCHMARK(to_unordered_multimap_loop);
+EXSTREAM_BENCHMARK(to_unordered_multimap_stream);
+EXSTREAM_BENCHMARK(combine_vector_fold);
+EXSTREAM_BENCHMARK(combine_vector_range);
@@ -0,0 +1,75 @@
+#include "bench.hpp"
+
+#include "stream_of.hpp"
+#include "stream_of_columns.hpp"
+#include "collectors/collectors.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <tuple>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+// NOTE: the key is the only hot field, the payload is dead weight for the row-wise scan
+#define EXSTREAM_COLUMNS_BENCHMARK(function)\
+    BENCHMARK_TEMPLATE(function, 16)->Apply(::exstream::bench::apply_sizes<::exstream::bench::record<16>>);\
+    BENCHMARK_TEMPLATE(function, 64)->Apply(::exstream::bench::apply_sizes<::exstream::bench::record<64>>);\
+    BENCHMARK_TEMPLATE(function, 256)->Apply(::exstream::bench::apply_sizes<::exstream::bench::record<256>>)
+
+using namespace exstream;
+using namespace exstream::bench;
+
+template <size_t Size>
+using row = std::tuple<int32_t, std::array<char, Size - sizeof(int32_t)>>;
+
+template <size_t Size>
+static std::vector<row<Size>> make_rows(const size_t count)
+{
+    std::vector<row<Size>> rows;
+    rows.reserve(count);
+
+    for (const auto& value : make_input<record<Size>>(count))
+        rows.emplace_back(value.key, value.payload);
+
+    return rows;
+}
+
+template <size_t Size>
+static void sum_keys_rows_stream(benchmark::State& state)
+{
+    const auto rows = make_rows<Size>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        int64_t sum = 0;
+        stream_of(rows).foreach([&](const auto& value) { sum += std::get<0>(value); });
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <size_t Size>
+static void sum_keys_columns_stream(benchmark::State& state)
+{
+    const auto columns = stream_of(make_rows<Size>(size_t(state.range(0)))).collect(to_columns());
+
+    run(state, [&]
+    {
+        int64_t sum = 0;
+        stream_of_columns(columns).foreach([&](const auto& value) { sum += std::get<0>(value); });
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <size_t Size>
+static void to_columns_stream(benchmark::State& state)
+{
+    const auto rows = make_rows<Size>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        auto result = stream_of(rows).collect(to_columns());
+        benchmark::DoNotOptimize(result);
+    });
+}
+
+EXSTREAM_COLUMNS_BENCHMARK(sum_keys_rows_stream);
+EXSTREAM_COLUMNS_BENCHMARK(sum_keys_columns_stream);
+EXSTREAM_COLUMNS_BENCHMARK(to_columns_stream);
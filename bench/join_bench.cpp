@@ -0,0 +1,66 @@
+#include "bench.hpp"
+
+#include "stream_of.hpp"
+#include "combinators/combinators.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <iterator>
+#include <unordered_map>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+using namespace exstream;
+using namespace exstream::bench;
+
+// NOTE: the lookup table is a tenth of the streamed input, so about a tenth of the probe elements find a match
+template <typename T>
+static void join_map_stream(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+    const auto lookup = make_input<T>(input.size() / 10);
+
+    run(state, [&]
+    {
+        std::unordered_multimap<int32_t, const T*> table;
+        stream_of(lookup).foreach([&](const T& value) { table.emplace(key_of(value), &value); });
+
+        size_t matches = 0;
+        stream_of(input).foreach([&](const T& value)
+        {
+            const auto range = table.equal_range(key_of(value));
+            matches += size_t(std::distance(range.first, range.second));
+        });
+        benchmark::DoNotOptimize(matches);
+    });
+}
+
+template <typename T>
+static void hash_join_stream(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+    const auto lookup = make_input<T>(input.size() / 10);
+    const auto key = [](const T& value) { return key_of(value); };
+
+    run(state, [&]
+    {
+        auto matches = hash_join(stream_of(input), stream_of(lookup), key, key).count();
+        benchmark::DoNotOptimize(matches);
+    });
+}
+
+template <typename T>
+static void semi_hash_join_stream(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+    const auto lookup = make_input<T>(input.size() / 10);
+    const auto key = [](const T& value) { return key_of(value); };
+
+    run(state, [&]
+    {
+        auto matches = semi_hash_join(stream_of(input), stream_of(lookup), key, key).count();
+        benchmark::DoNotOptimize(matches);
+    });
+}
+
+EXSTREAM_BENCHMARK(join_map_stream);
+EXSTREAM_BENCHMARK(hash_join_stream);
+EXSTREAM_BENCHMARK(semi_hash_join_stream);
@@ -0,0 +1,41 @@
+#include "bench.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+static std::atomic<size_t> allocations(0);
+
+void* operator new (const size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (auto ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete (void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete (void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace exstream {
+namespace bench {
+
+size_t allocations_count() noexcept
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+}} // exstream::bench namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,194 @@
+#include "bench.hpp"
+
+#include "stream_of.hpp"
+#include "make_array.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <unordered_set>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+using namespace exstream;
+using namespace exstream::bench;
+
+template <typename T>
+static void map_loop(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        int64_t sum = 0;
+        for (const auto& value : input)
+            sum += key_of(value) * 2;
+
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <typename T>
+static void map_stream(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        int64_t sum = 0;
+        stream_of(input)
+            .map([](const auto& value) { return key_of(value) * 2; })
+            .foreach([&](const int value) { sum += value; });
+
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <typename T>
+static void filter_loop(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        int64_t sum = 0;
+        for (const auto& value : input)
+        {
+            if (key_of(value) % 2 == 0)
+                sum += key_of(value);
+        }
+
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <typename T>
+static void filter_stream(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        int64_t sum = 0;
+        stream_of(input)
+            .filter([](const auto& value) { return key_of(value) % 2 == 0; })
+            .foreach([&](const auto& value) { sum += key_of(value); });
+
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <typename T>
+static void flat_map_loop(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        int64_t sum = 0;
+        for (const auto& value : input)
+        {
+            for (const auto inner : make_array(key_of(value), key_of(value) + 1))
+                sum += inner;
+        }
+
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <typename T>
+static void flat_map_stream(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        int64_t sum = 0;
+        stream_of(input)
+            .flat_map([](const auto& value) { return make_array(key_of(value), key_of(value) + 1); })
+            .foreach([&](const int value) { sum += value; });
+
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <typename T>
+static void flat_map_into_stream(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        int64_t sum = 0;
+        stream_of(input)
+            .template flat_map_into<int>([](const auto& value, auto& emit)
+            {
+                emit(key_of(value));
+                emit(key_of(value) + 1);
+            })
+            .foreach([&](const int value) { sum += value; });
+
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <typename T>
+static void distinct_loop(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        int64_t sum = 0;
+        std::unordered_set<T> set;
+        set.reserve(input.size());
+
+        for (const auto& value : input)
+        {
+            if (set.insert(value).second)
+                sum += key_of(value);
+        }
+
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <typename T>
+static void distinct_stream(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        int64_t sum = 0;
+        stream_of(input)
+            .distinct()
+            .foreach([&](const auto& value) { sum += key_of(value); });
+
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <typename T>
+static void bloom_distinct_stream(benchmark::State& state)
+{
+    const auto input = make_input<T>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        int64_t sum = 0;
+        stream_of(input)
+            .bloom_distinct()
+            .foreach([&](const auto& value) { sum += key_of(value); });
+
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+EXSTREAM_BENCHMARK(map_loop);
+EXSTREAM_BENCHMARK(map_stream);
+EXSTREAM_BENCHMARK(filter_loop);
+EXSTREAM_BENCHMARK(filter_stream);
+EXSTREAM_BENCHMARK(flat_map_loop);
+EXSTREAM_BENCHMARK(flat_map_stream);
+EXSTREAM_BENCHMARK(flat_map_into_stream);
+EXSTREAM_BENCHMARK(distinct_loop);
+EXSTREAM_BENCHMARK(distinct_stream);
+EXSTREAM_BENCHMARK(bloom_distinct_stream);
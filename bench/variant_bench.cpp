@@ -0,0 +1,162 @@
+#include "bench.hpp"
+
+#include "variant.hpp"
+
+using namespace exstream;
+using namespace exstream::bench;
+
+// NOTE: dispatch benchmarks run for messages of 8, 24 and 40 alternatives
+#define EXSTREAM_VARIANT_BENCHMARK(function)\
+    BENCHMARK_TEMPLATE(function, 8)->Apply(apply_messages_counts);\
+    BENCHMARK_TEMPLATE(function, 24)->Apply(apply_messages_counts);\
+    BENCHMARK_TEMPLATE(function, 40)->Apply(apply_messages_counts)
+
+template <size_t Index>
+struct packet final
+{
+    uint32_t payload;
+
+    uint32_t weight() const noexcept
+    {
+        return payload ^ uint32_t(Index);
+    }
+};
+
+template <size_t... Indices>
+variant<packet<Indices>...> make_message_type(std::index_sequence<Indices...>);
+
+template <size_t AlternativesCount>
+using message = decltype(make_message_type(std::make_index_sequence<AlternativesCount>()));
+
+template <typename Message, size_t Index>
+static Message make_message(const uint32_t payload)
+{
+    return Message(packet<Index>{ payload });
+}
+
+template <typename Message, size_t... Indices>
+static Message make_message(const size_t index, const uint32_t payload, std::index_sequence<Indices...>)
+{
+    using function_t = Message (*)(uint32_t);
+    static constexpr function_t makers[] = { &make_message<Message, Indices>... };
+    return makers[index](payload);
+}
+
+// NOTE: alternatives are uniformly distributed, so the branch predictor can't learn the dispatch
+template <size_t AlternativesCount>
+static std::vector<message<AlternativesCount>> make_messages(const size_t count)
+{
+    std::vector<message<AlternativesCount>> messages;
+    messages.reserve(count);
+
+    uint32_t seed = 42;
+    for (size_t i = 0; i < count; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        messages.push_back(make_message<message<AlternativesCount>>(size_t(seed >> 8) % AlternativesCount, seed,
+                                                                    std::make_index_sequence<AlternativesCount>()));
+    }
+
+    return messages;
+}
+
+static void apply_messages_counts(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->Arg(4096)->Arg(65536)->Arg(1048576);
+}
+
+// NOTE: reproduces the previous recursive dispatch, which compared the index with every alternative in turn
+template <size_t Index, typename Variant, typename Function>
+EXSTREAM_FORCEINLINE decltype(auto) linear_match(const Variant& value, const Function& function, std::true_type /* last alternative */)
+{
+    using alternative = typename detail::variant_traits_t<Variant>::template alternative<Index>;
+    return function(value.template get<alternative>());
+}
+
+template <size_t Index, typename Variant, typename Function>
+EXSTREAM_FORCEINLINE decltype(auto) linear_match(const Variant& value, const Function& function, std::false_type /* last alternative */)
+{
+    using alternative = typename detail::variant_traits_t<Variant>::template alternative<Index>;
+    using is_last = std::bool_constant<Index + 2 == detail::variant_traits_t<Variant>::size>;
+
+    if (value.index() == Index)
+        return function(value.template get<alternative>());
+
+    return linear_match<Index + 1>(value, function, is_last());
+}
+
+template <typename Variant, typename Function>
+EXSTREAM_FORCEINLINE decltype(auto) linear_match(const Variant& value, const Function& function)
+{
+    return linear_match<0>(value, function, std::bool_constant<detail::variant_traits_t<Variant>::size == 1>());
+}
+
+template <size_t AlternativesCount>
+static void match_linear(benchmark::State& state)
+{
+    const auto messages = make_messages<AlternativesCount>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        uint64_t sum = 0;
+        for (const auto& value : messages)
+            sum += linear_match(value, [](const auto& packet) { return packet.weight(); });
+
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <size_t AlternativesCount>
+static void match_table(benchmark::State& state)
+{
+    const auto messages = make_messages<AlternativesCount>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        uint64_t sum = 0;
+        for (const auto& value : messages)
+            sum += value.match([](const auto& packet) { return packet.weight(); });
+
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <size_t AlternativesCount>
+static void match_pairs_linear(benchmark::State& state)
+{
+    const auto messages = make_messages<AlternativesCount>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        uint64_t sum = 0;
+        for (size_t i = 1; i < messages.size(); ++i)
+        {
+            sum += linear_match(messages[i - 1], [&](const auto& lhs)
+            {
+                return linear_match(messages[i], [&](const auto& rhs) { return lhs.weight() * rhs.weight(); });
+            });
+        }
+
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+template <size_t AlternativesCount>
+static void match_pairs_table(benchmark::State& state)
+{
+    const auto messages = make_messages<AlternativesCount>(size_t(state.range(0)));
+
+    run(state, [&]
+    {
+        uint64_t sum = 0;
+        for (size_t i = 1; i < messages.size(); ++i)
+            sum += match([](const auto& lhs, const auto& rhs) { return lhs.weight() * rhs.weight(); }, messages[i - 1], messages[i]);
+
+        benchmark::DoNotOptimize(sum);
+    });
+}
+
+EXSTREAM_VARIANT_BENCHMARK(match_linear);
+EXSTREAM_VARIANT_BENCHMARK(match_table);
+EXSTREAM_VARIANT_BENCHMARK(match_pairs_linear);
+EXSTREAM_VARIANT_BENCHMARK(match_pairs_table);
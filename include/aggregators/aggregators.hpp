@@ -0,0 +1,7 @@
+#pragma once
+
+#include "running_stats.hpp"
+#include "tdigest.hpp"
+#include "hyperloglog.hpp"
+#include "bloom_filter.hpp"
+#include "space_saving.hpp"
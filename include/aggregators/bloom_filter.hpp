@@ -0,0 +1,123 @@
+#pragma once
+
+#include "detail/hash.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+// NOTE: a set membership test in a fixed bit array, an added element is always found,
+//       other elements are found with the false positive rate while no more than the expected count is added
+template <typename Allocator = std::allocator<uint64_t>>
+class bloom_filter final
+{
+    using word_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<uint64_t>;
+public:
+
+    static constexpr double default_fp_rate = 0.01;
+
+    explicit bloom_filter(const size_t expectedCount, const double fpRate = default_fp_rate, const Allocator& alloc = Allocator())
+        : words(optimal_words_count(expectedCount, fpRate), uint64_t(0), word_allocator(alloc)),
+          hashCount(optimal_hash_count(words.size() * 64, expectedCount))
+    {
+        assert(fpRate > 0.0 && fpRate < 1.0 && "False positive rate should be in (0, 1)");
+    }
+
+    // NOTE: returns false if the element is (probably) added already
+    template <typename T>
+    bool add(const T& value)
+    {
+        return add_hash(detail::hash_of(value));
+    }
+
+    bool add_hash(const uint64_t hash) noexcept
+    {
+        bool added = false;
+        visit(words, hashCount, hash, [&](uint64_t& word, const uint64_t mask) noexcept
+        {
+            added |= (word & mask) == 0;
+            word |= mask;
+            return true;
+        });
+
+        return added;
+    }
+
+    template <typename T>
+    bool contains(const T& value) const
+    {
+        return contains_hash(detail::hash_of(value));
+    }
+
+    bool contains_hash(const uint64_t hash) const noexcept
+    {
+        return visit(words, hashCount, hash, [](const uint64_t& word, const uint64_t mask) noexcept
+        {
+            return (word & mask) != 0;
+        });
+    }
+
+    // NOTE: the filters should be created with the same parameters
+    void merge(const bloom_filter& that) noexcept
+    {
+        assert(words.size() == that.words.size() && hashCount == that.hashCount && "Filters of different sizes can't be merged");
+
+        for (size_t i = 0; i < words.size(); ++i)
+            words[i] |= that.words[i];
+    }
+
+    size_t bit_count() const noexcept
+    {
+        return words.size() * 64;
+    }
+
+    size_t hash_count() const noexcept
+    {
+        return hashCount;
+    }
+
+private:
+
+    static size_t optimal_words_count(const size_t expectedCount, const double fpRate) noexcept
+    {
+        const auto ln2 = std::log(2.0);
+        const auto bits = std::ceil(-double(std::max(expectedCount, size_t(1))) * std::log(fpRate) / (ln2 * ln2));
+        return std::max(size_t(1), (static_cast<size_t>(bits) + 63) / 64);
+    }
+
+    static size_t optimal_hash_count(const size_t bits, const size_t expectedCount) noexcept
+    {
+        const auto count = std::llround(double(bits) / double(std::max(expectedCount, size_t(1))) * std::log(2.0));
+        return static_cast<size_t>(std::min(std::max(count, 1ll), 30ll));
+    }
+
+    // NOTE: the probed bits are derived from a single hash by the double hashing, the visitor may stop the probing
+    template <typename Words, typename Visitor>
+    static bool visit(Words& words, const size_t hashCount, const uint64_t hash, Visitor&& visitor) noexcept
+    {
+        const auto bits = uint64_t(words.size()) * 64;
+        const auto step = detail::mix_hash(hash) | 1;
+
+        auto position = hash;
+        for (size_t i = 0; i < hashCount; ++i, position += step)
+        {
+            const auto bit = position % bits;
+            if (!visitor(words[size_t(bit / 64)], uint64_t(1) << (bit % 64)))
+                return false;
+        }
+
+        return true;
+    }
+
+    std::vector<uint64_t, word_allocator> words;
+    size_t hashCount;
+};
+
+} // exstream namespace
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "detail/hash.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+// NOTE: the estimation of the distinct elements count in 2^precision one byte registers,
+//       the standard error is about 1.04 / sqrt(2^precision), 1.6% for the default precision
+class hyperloglog final
+{
+public:
+
+    static constexpr uint32_t default_precision = 12;
+
+    explicit hyperloglog(const uint32_t precision = default_precision)
+        : registers(size_t(1) << precision, uint8_t(0)),
+          precision(precision)
+    {
+        assert(precision >= 4 && precision <= 18 && "Precision should be in [4, 18]");
+    }
+
+    template <typename T>
+    void add(const T& value)
+    {
+        add_hash(detail::hash_of(value));
+    }
+
+    // NOTE: the hash should be uniformly distributed over all its 64 bits
+    void add_hash(const uint64_t hash) noexcept
+    {
+        const auto index = size_t(hash >> (64 - precision));
+
+        // NOTE: the sentinel bit bounds the rank by the count of the remaining bits
+        auto rest = (hash << precision) | (uint64_t(1) << (precision - 1));
+        uint8_t rank = 1;
+        for (; (rest & (uint64_t(1) << 63)) == 0; rest <<= 1)
+            ++rank;
+
+        registers[index] = std::max(registers[index], rank);
+    }
+
+    // NOTE: the sketches should have the same precision
+    void merge(const hyperloglog& that) noexcept
+    {
+        assert(precision == that.precision && "Sketches of different precision can't be merged");
+
+        for (size_t i = 0; i < registers.size(); ++i)
+            registers[i] = std::max(registers[i], that.registers[i]);
+    }
+
+    double estimate() const noexcept
+    {
+        const auto m = static_cast<double>(registers.size());
+
+        auto harmonicSum = 0.0;
+        size_t zeros = 0;
+        for (const auto value : registers)
+        {
+            harmonicSum += std::ldexp(1.0, -int(value));
+            zeros += (value == 0) ? 1 : 0;
+        }
+
+        const auto raw = alpha(m) * m * m / harmonicSum;
+
+        // NOTE: the linear counting is more precise for small cardinalities
+        if (raw <= 2.5 * m && zeros != 0)
+            return m * std::log(m / static_cast<double>(zeros));
+
+        return raw;
+    }
+
+    size_t count() const noexcept
+    {
+        return static_cast<size_t>(std::llround(estimate()));
+    }
+
+    uint32_t get_precision() const noexcept
+    {
+        return precision;
+    }
+
+private:
+
+    static double alpha(const double m) noexcept
+    {
+        if (m == 16.0) return 0.673;
+        if (m == 32.0) return 0.697;
+        if (m == 64.0) return 0.709;
+        return 0.7213 / (1.0 + 1.079 / m);
+    }
+
+    std::vector<uint8_t> registers;
+    uint32_t precision;
+};
+
+} // exstream namespace
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "config.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+// NOTE: count, sum, extremes, mean and variance in a single pass, the variance is updated by the Welford method,
+//       so it doesn't lose the precision on large sums of squares
+class running_stats final
+{
+public:
+
+    running_stats() noexcept
+        : elementsCount(0),
+          total(0.0),
+          average(0.0),
+          squares(0.0),
+          minimum(std::numeric_limits<double>::infinity()),
+          maximum(-std::numeric_limits<double>::infinity())
+    {
+    }
+
+    template <typename T>
+    void add(const T& value) noexcept
+    {
+        const auto x = static_cast<double>(value);
+        const auto delta = x - average;
+
+        ++elementsCount;
+        total += x;
+        average += delta / static_cast<double>(elementsCount);
+        squares += delta * (x - average);
+        minimum = std::min(minimum, x);
+        maximum = std::max(maximum, x);
+    }
+
+    // NOTE: combines the statistics of two disjoint parts of a stream
+    void merge(const running_stats& that) noexcept
+    {
+        if (that.elementsCount == 0) return;
+        if (elementsCount == 0)
+        {
+            *this = that;
+            return;
+        }
+
+        const auto count = elementsCount + that.elementsCount;
+        const auto delta = that.average - average;
+        const auto thisWeight = static_cast<double>(elementsCount);
+        const auto thatWeight = static_cast<double>(that.elementsCount);
+
+        squares += that.squares + delta * delta * thisWeight * thatWeight / static_cast<double>(count);
+        average += delta * thatWeight / static_cast<double>(count);
+        elementsCount = count;
+        total += that.total;
+        minimum = std::min(minimum, that.minimum);
+        maximum = std::max(maximum, that.maximum);
+    }
+
+    size_t count() const noexcept
+    {
+        return elementsCount;
+    }
+
+    double sum() const noexcept
+    {
+        return total;
+    }
+
+    double mean() const noexcept
+    {
+        return (elementsCount == 0) ? std::numeric_limits<double>::quiet_NaN() : average;
+    }
+
+    // NOTE: the population variance, see sample_variance for the unbiased estimation
+    double variance() const noexcept
+    {
+        return (elementsCount == 0) ? std::numeric_limits<double>::quiet_NaN() : squares / static_cast<double>(elementsCount);
+    }
+
+    double sample_variance() const noexcept
+    {
+        return (elementsCount < 2) ? std::numeric_limits<double>::quiet_NaN() : squares / static_cast<double>(elementsCount - 1);
+    }
+
+    double stddev() const noexcept
+    {
+        return std::sqrt(variance());
+    }
+
+    double min() const noexcept
+    {
+        return (elementsCount == 0) ? std::numeric_limits<double>::quiet_NaN() : minimum;
+    }
+
+    double max() const noexcept
+    {
+        return (elementsCount == 0) ? std::numeric_limits<double>::quiet_NaN() : maximum;
+    }
+
+private:
+
+    size_t elementsCount;
+    double total;
+    double average;
+    double squares;
+    double minimum;
+    double maximum;
+};
+
+} // exstream namespace
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "detail/hash.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+// NOTE: the count is an upper bound of the real count, it exceeds the real count by no more than the error
+template <typename T>
+struct heavy_hitter final
+{
+    T value;
+    size_t count;
+    size_t error;
+};
+
+// NOTE: the Space-Saving sketch of the most frequent elements in capacity counters. Every element
+//       which occurs more than count() / capacity times is tracked, the counts overestimate by count() / capacity at most.
+//       The counters are kept in a min-heap, an untracked element replaces the least frequent one
+template <typename T, typename Hash = detail::mixed_hash<T>, typename Equal = std::equal_to<T>>
+class space_saving final
+{
+public:
+
+    explicit space_saving(const size_t capacity)
+        : counters(),
+          positions(),
+          capacity(capacity),
+          total(0)
+    {
+        assert(capacity != 0 && "Capacity should be positive");
+
+        counters.reserve(capacity);
+        positions.reserve(capacity);
+    }
+
+    void add(const T& value)
+    {
+        ++total;
+
+        const auto found = positions.find(value);
+        if (found != positions.end())
+        {
+            ++counters[found->second].count;
+            sift_down(found->second);
+            return;
+        }
+
+        if (counters.size() != capacity)
+        {
+            counters.push_back(heavy_hitter<T>{ value, 1, 0 });
+            positions.emplace(value, counters.size() - 1);
+            sift_up(counters.size() - 1);
+            return;
+        }
+
+        auto& least = counters.front();
+        positions.erase(least.value);
+
+        least.value = value;
+        least.error = least.count;
+        ++least.count;
+
+        positions.emplace(value, 0);
+        sift_down(0);
+    }
+
+    // NOTE: an upper bound of the count of the element
+    size_t estimate(const T& value) const
+    {
+        const auto found = positions.find(value);
+        if (found != positions.end()) return counters[found->second].count;
+
+        return (counters.size() == capacity) ? counters.front().count : 0;
+    }
+
+    // NOTE: the tracked elements from the most frequent one
+    std::vector<heavy_hitter<T>> top() const
+    {
+        std::vector<heavy_hitter<T>> result(counters.cbegin(), counters.cend());
+        std::sort(result.begin(), result.end(), [](const auto& left, const auto& right)
+        {
+            return left.count > right.count;
+        });
+
+        return result;
+    }
+
+    size_t count() const noexcept
+    {
+        return total;
+    }
+
+    size_t get_capacity() const noexcept
+    {
+        return capacity;
+    }
+
+private:
+
+    void sift_up(size_t index)
+    {
+        while (index != 0)
+        {
+            const auto parent = (index - 1) / 2;
+            if (counters[parent].count <= counters[index].count) break;
+
+            swap_counters(parent, index);
+            index = parent;
+        }
+    }
+
+    void sift_down(size_t index)
+    {
+        for (;;)
+        {
+            const auto left = index * 2 + 1;
+            const auto right = left + 1;
+
+            auto least = index;
+            if (left < counters.size() && counters[left].count < counters[least].count) least = left;
+            if (right < counters.size() && counters[right].count < counters[least].count) least = right;
+            if (least == index) break;
+
+            swap_counters(least, index);
+            index = least;
+        }
+    }
+
+    void swap_counters(const size_t first, const size_t second)
+    {
+        std::swap(counters[first], counters[second]);
+        positions.find(counters[first].value)->second = first;
+        positions.find(counters[second].value)->second = second;
+    }
+
+    std::vector<heavy_hitter<T>> counters;
+    std::unordered_map<T, size_t, Hash, Equal> positions;
+    size_t capacity;
+    size_t total;
+};
+
+} // exstream namespace
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "config.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+// NOTE: a merging t-digest, the stream is summarized by weighted centroids which are small near the tails,
+//       so the extreme quantiles are precise. The added values are buffered and merged into the centroids when
+//       the buffer is full, both are allocated at the construction and never grow
+class tdigest final
+{
+    struct centroid final
+    {
+        double mean;
+        double weight;
+
+        bool operator< (const centroid& that) const noexcept
+        {
+            return mean < that.mean;
+        }
+    };
+
+public:
+
+    static constexpr double default_compression = 100.0;
+
+    explicit tdigest(const double compression = default_compression)
+        : compression(compression),
+          centroids(),
+          buffer(),
+          scratch(),
+          totalWeight(0.0),
+          minimum(std::numeric_limits<double>::infinity()),
+          maximum(-std::numeric_limits<double>::infinity())
+    {
+        assert(compression >= 10.0 && "Compression is too small");
+
+        // NOTE: the scale function bounds the number of the merged centroids by the compression
+        const auto capacity = static_cast<size_t>(std::ceil(compression)) + 1;
+        centroids.reserve(capacity * 2);
+        buffer.reserve(capacity * 5);
+        scratch.reserve(capacity * 7);
+    }
+
+    template <typename T>
+    void add(const T& value)
+    {
+        add(static_cast<double>(value), 1.0);
+    }
+
+    void add(const double value, const double weight)
+    {
+        if (buffer.size() == buffer.capacity())
+            compress();
+
+        buffer.push_back(centroid{ value, weight });
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+    }
+
+    void merge(const tdigest& that)
+    {
+        const auto append = [this](const std::vector<centroid>& source)
+        {
+            for (const auto& entry : source)
+            {
+                if (buffer.size() == buffer.capacity())
+                    compress();
+
+                buffer.push_back(entry);
+            }
+        };
+
+        append(that.centroids);
+        append(that.buffer);
+
+        minimum = std::min(minimum, that.minimum);
+        maximum = std::max(maximum, that.maximum);
+    }
+
+    double count() const noexcept
+    {
+        return totalWeight + buffered_weight();
+    }
+
+    // NOTE: the estimation of the value below which the q fraction of the stream lies, q is in [0, 1]
+    double quantile(const double q)
+    {
+        assert(q >= 0.0 && q <= 1.0 && "Quantile should be in [0, 1]");
+
+        compress();
+        if (centroids.empty()) return std::numeric_limits<double>::quiet_NaN();
+        if (centroids.size() == 1) return centroids.front().mean;
+
+        const auto index = q * totalWeight;
+        const auto& first = centroids.front();
+        if (index < first.weight / 2)
+            return minimum + (first.mean - minimum) * index / (first.weight / 2);
+
+        auto cumulative = 0.0;
+        for (size_t i = 0; i + 1 < centroids.size(); ++i)
+        {
+            const auto& left = centroids[i];
+            const auto& right = centroids[i + 1];
+
+            const auto leftCenter = cumulative + left.weight / 2;
+            const auto rightCenter = cumulative + left.weight + right.weight / 2;
+            if (index < rightCenter)
+                return left.mean + (right.mean - left.mean) * (index - leftCenter) / (rightCenter - leftCenter);
+
+            cumulative += left.weight;
+        }
+
+        const auto& last = centroids.back();
+        const auto lastCenter = totalWeight - last.weight / 2;
+        return last.mean + (maximum - last.mean) * (index - lastCenter) / (last.weight / 2);
+    }
+
+    double median()
+    {
+        return quantile(0.5);
+    }
+
+    double min() const noexcept
+    {
+        return (count() == 0.0) ? std::numeric_limits<double>::quiet_NaN() : minimum;
+    }
+
+    double max() const noexcept
+    {
+        return (count() == 0.0) ? std::numeric_limits<double>::quiet_NaN() : maximum;
+    }
+
+    size_t centroids_count()
+    {
+        compress();
+        return centroids.size();
+    }
+
+private:
+
+    double buffered_weight() const noexcept
+    {
+        auto result = 0.0;
+        for (const auto& entry : buffer)
+            result += entry.weight;
+
+        return result;
+    }
+
+    // NOTE: the k1 scale function, a centroid may span a unit of k
+    double scale(const double q) const noexcept
+    {
+        return compression / (2.0 * pi()) * std::asin(2.0 * q - 1.0);
+    }
+
+    double inverse_scale(const double k) const noexcept
+    {
+        return (std::sin(std::min(k * 2.0 * pi() / compression, pi() / 2.0)) + 1.0) / 2.0;
+    }
+
+    static constexpr double pi() noexcept
+    {
+        return 3.14159265358979323846;
+    }
+
+    void compress()
+    {
+        if (buffer.empty()) return;
+
+        std::sort(buffer.begin(), buffer.end());
+
+        scratch.clear();
+        std::merge(centroids.cbegin(), centroids.cend(), buffer.cbegin(), buffer.cend(), std::back_inserter(scratch));
+
+        totalWeight += buffered_weight();
+        buffer.clear();
+        centroids.clear();
+
+        auto current = scratch.front();
+        auto mergedWeight = 0.0;
+        auto limit = totalWeight * inverse_scale(scale(0.0) + 1.0);
+
+        for (auto iter = std::next(scratch.cbegin()); iter != scratch.cend(); ++iter)
+        {
+            if (mergedWeight + current.weight + iter->weight <= limit)
+            {
+                current.weight += iter->weight;
+                current.mean += (iter->mean - current.mean) * iter->weight / current.weight;
+                continue;
+            }
+
+            mergedWeight += current.weight;
+            centroids.push_back(current);
+
+            limit = totalWeight * inverse_scale(scale(mergedWeight / totalWeight) + 1.0);
+            current = *iter;
+        }
+
+        centroids.push_back(current);
+    }
+
+    double compression;
+    std::vector<centroid> centroids;
+    std::vector<centroid> buffer;
+    std::vector<centroid> scratch;
+    double totalWeight;
+    double minimum;
+    double maximum;
+};
+
+} // exstream namespace
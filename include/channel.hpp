@@ -0,0 +1,230 @@
+#pragma once
+
+#include "stream_of.hpp"
+#include "option.hpp"
+#include "meta_info.hpp"
+#include "detail/mpmc_queue.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+// NOTE: a bounded queue between producer and consumer threads. The producers wait while it is full
+//       and the consumers while it is empty, close it after the last push to let the consumers finish
+template <typename T, typename Allocator = std::allocator<T>>
+class channel final
+{
+public:
+
+    using value_type = T;
+
+    explicit channel(const size_t capacity, const Allocator& alloc = Allocator())
+        : queue(capacity, alloc),
+          isClosed(false)
+    {
+    }
+
+    channel(const channel&) = delete;
+    channel(channel&&) = delete;
+
+    channel& operator= (const channel&) = delete;
+    channel& operator= (channel&&) = delete;
+
+    // NOTE: fails if the channel is full or closed, the value is untouched on failure
+    template <typename... Args>
+    bool try_push(Args&&... args)
+    {
+        if (closed()) return false;
+        return queue.try_push(std::forward<Args>(args)...);
+    }
+
+    // NOTE: fails only if the channel is closed
+    template <typename... Args>
+    bool push(Args&&... args)
+    {
+        while (!try_push(std::forward<Args>(args)...))
+        {
+            if (closed()) return false;
+            std::this_thread::yield();
+        }
+
+        return true;
+    }
+
+    option<T> try_pop()
+    {
+        option<T> result;
+        queue.try_pop(result);
+        return result;
+    }
+
+    // NOTE: the result is empty if the channel is closed and drained
+    option<T> pop()
+    {
+        option<T> result;
+        while (!queue.try_pop(result))
+        {
+            if (closed())
+            {
+                queue.try_pop(result);
+                break;
+            }
+
+            std::this_thread::yield();
+        }
+
+        return result;
+    }
+
+    void close() noexcept
+    {
+        isClosed.store(true, std::memory_order_release);
+    }
+
+    bool closed() const noexcept
+    {
+        return isClosed.load(std::memory_order_acquire);
+    }
+
+private:
+
+    detail::mpmc_queue<T, Allocator> queue;
+    std::atomic<bool> isClosed;
+};
+
+// NOTE: pops the channel until it is closed and drained, several streams of a channel share its elements
+template <typename T, typename Allocator>
+class channel_iterator final
+{
+public:
+
+    using value_type = T;
+    using result_type = T;
+
+    explicit channel_iterator(channel<T, Allocator>& source) noexcept
+        : source(std::addressof(source)),
+          current()
+    {
+    }
+
+    bool has_next()
+    {
+        if (current.empty()) current = source->pop();
+        return current.non_empty();
+    }
+
+    result_type next()
+    {
+        const bool found = has_next();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        T result = std::move(current.get());
+        current.reset();
+        return result;
+    }
+
+    void skip()
+    {
+        const bool found = has_next();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        current.reset();
+    }
+
+    size_t elements_count() const noexcept
+    {
+        return unknown_count;
+    }
+
+private:
+
+    channel<T, Allocator>* source;
+    option<T> current;
+};
+
+template <typename T, typename Allocator>
+class channel_builder final
+{
+public:
+
+    explicit channel_builder(channel<T, Allocator>& target) noexcept
+        : target(std::addressof(target))
+    {
+    }
+
+    channel_builder(channel_builder&&) = default;
+
+    channel_builder(const channel_builder&) = delete;
+    channel_builder& operator= (const channel_builder&) = delete;
+
+    void reserve(const size_t) const noexcept
+    {
+    }
+
+    // NOTE: the elements pushed to a closed channel are dropped
+    template <typename U>
+    void append(U&& value)
+    {
+        target->push(std::forward<U>(value));
+    }
+
+    void build() const noexcept
+    {
+    }
+
+private:
+
+    channel<T, Allocator>* target;
+};
+
+// NOTE: the collect waits while the channel is full, so a slow consumer throttles the pipeline.
+//       The channel isn't closed by the collect, other pipelines may push to it as well
+template <typename T, typename Allocator>
+class channel_sink final
+{
+public:
+
+    explicit channel_sink(channel<T, Allocator>& target) noexcept
+        : target(std::addressof(target))
+    {
+    }
+
+    channel_sink(channel_sink&&) = default;
+
+    channel_sink(const channel_sink&) = delete;
+    channel_sink& operator= (const channel_sink&) = delete;
+
+    template <typename U>
+    auto builder(type_t<U>) const noexcept -> std::enable_if_t<std::is_constructible_v<T, U&&>, channel_builder<T, Allocator>>
+    {
+        return channel_builder<T, Allocator>(*target);
+    }
+
+private:
+
+    channel<T, Allocator>* target;
+};
+
+template <typename T, typename Allocator>
+auto to_channel(channel<T, Allocator>& target) noexcept
+{
+    return channel_sink<T, Allocator>(target);
+}
+
+template <typename Allocator = std::allocator<unsigned char>, typename T, typename ChannelAllocator>
+auto stream_of(channel<T, ChannelAllocator>& source, const Allocator& alloc = Allocator())
+{
+    using meta = meta_info<false, false, Order::Unknown>;
+    return detail::make_stream<meta>(channel_iterator<T, ChannelAllocator>(source), alloc);
+}
+
+} // exstream namespace
@@ -3,6 +3,11 @@
 #include "config.hpp"
 #include "utility.hpp"
 
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cassert>
+#include <iterator>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
 namespace std {
 
 template <typename T>
@@ -12,6 +17,8 @@ class allocator;
 
 namespace exstream {
 
+// NOTE: the elements are appended to the underlying container, so the builders combine by moving the elements,
+//       and the adaptor is made at build. The initial adaptor of a collector is kept by its first builder only
 template <typename T,
           typename Container,
           template <typename, typename> class Adaptor>
@@ -23,7 +30,8 @@ public:
     adaptor_builder() = default;
 
     explicit adaptor_builder(adaptor_t&& adaptor)
-        : adaptor(std::move(adaptor))
+        : adaptor(std::move(adaptor)),
+          container()
     {
     }
 
@@ -38,22 +46,37 @@ public:
 
     void append(const T& value)
     {
-        adaptor.push(value);
+        container.push_back(value);
     }
 
     void append(T&& value)
     {
-        adaptor.push(std::move(value));
+        container.push_back(std::move(value));
+    }
+
+    void combine(adaptor_builder&& that)
+    {
+        assert(that.adaptor.empty() && "Only the first builder may have the initial elements");
+
+        container.insert(std::end(container), std::make_move_iterator(std::begin(that.container)), std::make_move_iterator(std::end(that.container)));
+        that.container.clear();
     }
 
     adaptor_t build()
     {
+        if (adaptor.empty()) return adaptor_t(std::move(container));
+
+        for (auto& value : container)
+            adaptor.push(std::move(value));
+
+        container.clear();
         return std::move(adaptor);
     }
 
 private:
 
     adaptor_t adaptor;
+    Container container;
 };
 
 template <template <typename, typename> class Container,
@@ -82,8 +105,8 @@ class adaptor_collector final
     using adaptor_t = Adaptor<T, Container>;
 public:
 
-    explicit adaptor_collector(Container&& container)
-        : adaptor(std::move(container))
+    explicit adaptor_collector(adaptor_t&& adaptor)
+        : adaptor(std::move(adaptor))
     {
     }
 
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "overflow_policy.hpp"
+#include "detail/traits.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <array>
+#include <type_traits>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+template <typename T, size_t N>
+class array_builder final
+{
+public:
+
+    explicit array_builder(const Overflow policy) noexcept(std::is_nothrow_default_constructible_v<T>)
+        : array(),
+          count(0),
+          policy(policy)
+    {
+    }
+
+    array_builder(const array_builder&) = delete;
+    array_builder(array_builder&&) = default;
+
+    array_builder& operator= (const array_builder&) = delete;
+    array_builder& operator= (array_builder&&) = delete;
+
+    void reserve(const size_t size)
+    {
+        if (size > N && policy == Overflow::Throw) throw capacity_overflow();
+    }
+
+    void append(const T& value)
+    {
+        if (detail::overflow::check(policy, count, N))
+            array[count++] = value;
+    }
+
+    void append(T&& value)
+    {
+        if (detail::overflow::check(policy, count, N))
+            array[count++] = std::move(value);
+    }
+
+    void combine(array_builder&& that)
+    {
+        for (size_t i = 0; i < that.count; ++i)
+            append(std::move(that.array[i]));
+
+        that.count = 0;
+    }
+
+    std::array<T, N> build() noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        return std::move(array);
+    }
+
+private:
+
+    std::array<T, N> array;
+    size_t count;
+    Overflow policy;
+};
+
+// NOTE: collects up to N elements into std::array, the elements past the end of a shorter stream are value initialized
+template <size_t N>
+struct array_collector final
+{
+    explicit array_collector(const Overflow policy = Overflow::Throw) noexcept
+        : policy(policy)
+    {
+    }
+
+    array_collector(array_collector&&) noexcept = default;
+
+    array_collector(const array_collector&) = delete;
+    array_collector& operator= (const array_collector&) = delete;
+
+    template <typename T, typename = std::enable_if_t<std::is_default_constructible_v<T>>>
+    auto builder(type_t<T>) const noexcept(std::is_nothrow_default_constructible_v<T>)
+    {
+        return array_builder<T, N>(policy);
+    }
+
+    Overflow policy;
+};
+
+template <size_t N>
+auto to_array(const Overflow policy = Overflow::Throw) noexcept
+{
+    return array_collector<N>(policy);
+}
+
+} // exstream namespace
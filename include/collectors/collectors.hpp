@@ -11,3 +11,8 @@
 #include "unordered_set_collector.hpp"
 #include "map_collector.hpp"
 #include "unordered_map_collector.hpp"
+#include "concurrent_collector.hpp"
+#include "soa_collector.hpp"
+#include "static_vector_collector.hpp"
+#include "array_collector.hpp"
+#include "small_vector_collector.hpp"
@@ -0,0 +1,346 @@
+#pragma once
+
+#include "detail/traits.hpp"
+#include "detail/hardware.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+namespace concurrent {
+
+inline size_t default_shard_count() noexcept
+{
+    return std::max(size_t(1), size_t(4) * std::thread::hardware_concurrency());
+}
+
+// NOTE: the shard is chosen by the high bits of the fibonacci hashed key, the containers use the low bits
+//       for their buckets, so the keys of a shard still spread over its buckets
+template <typename Hash>
+class partition final
+{
+public:
+
+    partition(const Hash& hash, const size_t count)
+        : hash(hash),
+          bits(1)
+    {
+        while (bits < std::numeric_limits<size_t>::digits - 1 && (size_t(1) << bits) < count)
+            ++bits;
+    }
+
+    size_t count() const noexcept
+    {
+        return size_t(1) << bits;
+    }
+
+    template <typename Key>
+    size_t operator() (const Key& key) const
+    {
+        const auto mixed = hash(key) * size_t(0x9E3779B97F4A7C15ull >> (64 - std::numeric_limits<size_t>::digits));
+        return mixed >> (std::numeric_limits<size_t>::digits - bits);
+    }
+
+private:
+
+    Hash hash;
+    size_t bits;
+};
+
+// NOTE: the padding keeps the neighbouring shards on different cache lines, the vector of the shards
+//       doesn't honour an over-aligned element type before C++17
+template <typename Container>
+struct shard final
+{
+    std::mutex mutex;
+    Container container;
+    char padding[cache_line_size];
+};
+
+template <typename Container>
+using is_map = std::bool_constant<!std::is_same_v<typename Container::key_type, typename Container::value_type>>;
+
+}} // detail::concurrent namespace
+
+// NOTE: the result of a sharded collect, every key belongs to a single shard,
+//       so the lookups search one shard and the shards merge without conflicts
+template <typename Container>
+class sharded_unordered final
+{
+    using shard_allocator = typename std::allocator_traits<typename Container::allocator_type>::template rebind_alloc<Container>;
+    using partition_t = detail::concurrent::partition<typename Container::hasher>;
+public:
+
+    using key_type = typename Container::key_type;
+    using container_type = Container;
+    using shards_type = std::vector<Container, shard_allocator>;
+    using const_iterator = typename shards_type::const_iterator;
+
+    sharded_unordered(shards_type&& shards, const partition_t& partition)
+        : shards(std::move(shards)),
+          partition(partition)
+    {
+    }
+
+    sharded_unordered(sharded_unordered&&) = default;
+
+    sharded_unordered(const sharded_unordered&) = delete;
+    sharded_unordered& operator= (const sharded_unordered&) = delete;
+
+    size_t size() const noexcept
+    {
+        size_t result = 0;
+        for (const auto& shard : shards)
+            result += shard.size();
+
+        return result;
+    }
+
+    bool empty() const noexcept
+    {
+        return std::all_of(shards.cbegin(), shards.cend(), [](const auto& shard) { return shard.empty(); });
+    }
+
+    size_t shard_count() const noexcept
+    {
+        return shards.size();
+    }
+
+    const Container& shard_of(const key_type& key) const
+    {
+        return shards[partition(key)];
+    }
+
+    size_t count(const key_type& key) const
+    {
+        return shard_of(key).count(key);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return shards.cbegin();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return shards.cend();
+    }
+
+    // NOTE: moves the elements of the shards into the first one, the keys are copied as they are const in the containers
+    Container merge() &&
+    {
+        const auto total = size();
+        Container result = std::move(shards.front());
+        result.reserve(total);
+
+        for (size_t i = 1; i < shards.size(); ++i)
+        {
+            auto& shard = shards[i];
+            result.insert(std::make_move_iterator(shard.begin()), std::make_move_iterator(shard.end()));
+            shard.clear();
+        }
+
+        return result;
+    }
+
+private:
+
+    shards_type shards;
+    partition_t partition;
+};
+
+// NOTE: append may be called from many threads at once, it locks only the shard of the key.
+//       reserve and build aren't thread safe and should be called before and after the appending threads
+template <typename Container, bool Merge>
+class concurrent_unordered_builder final
+{
+    using shard_t = detail::concurrent::shard<Container>;
+    using shard_allocator = typename std::allocator_traits<typename Container::allocator_type>::template rebind_alloc<shard_t>;
+    using partition_t = detail::concurrent::partition<typename Container::hasher>;
+    using map_tag = detail::concurrent::is_map<Container>;
+public:
+
+    explicit concurrent_unordered_builder(const size_t shardCount)
+        : partition(typename Container::hasher(), shardCount),
+          shards(partition.count())
+    {
+    }
+
+    concurrent_unordered_builder(concurrent_unordered_builder&&) = default;
+
+    concurrent_unordered_builder(const concurrent_unordered_builder&) = delete;
+    concurrent_unordered_builder& operator= (const concurrent_unordered_builder&) = delete;
+
+    void reserve(const size_t size)
+    {
+        const auto shardSize = size / shards.size() + 1;
+        for (auto& shard : shards)
+            shard.container.reserve(shardSize);
+    }
+
+    template <typename Entry>
+    void append(Entry&& entry)
+    {
+        auto& target = shards[partition(key_of(entry, map_tag()))];
+
+        std::lock_guard<std::mutex> lock(target.mutex);
+        insert(target.container, std::forward<Entry>(entry), std::bool_constant<map_tag::value && is_tuple_n_v<2, remove_cvr_t<Entry>>>());
+    }
+
+    // NOTE: moves the elements of the other builder to the shards of their keys, it isn't thread safe
+    void combine(concurrent_unordered_builder&& that)
+    {
+        for (auto& shard : that.shards)
+        {
+            auto& source = shard.container;
+            for (auto& entry : source)
+                shards[partition(key_of(entry, map_tag()))].container.insert(std::move(entry));
+
+            source.clear();
+        }
+    }
+
+    auto build()
+    {
+        typename sharded_unordered<Container>::shards_type result;
+        result.reserve(shards.size());
+
+        for (auto& shard : shards)
+            result.push_back(std::move(shard.container));
+
+        return finish(sharded_unordered<Container>(std::move(result), partition), std::bool_constant<Merge>());
+    }
+
+private:
+
+    template <typename Entry>
+    static const Entry& key_of(const Entry& entry, std::false_type /* set */) noexcept
+    {
+        return entry;
+    }
+
+    template <typename Entry>
+    static const auto& key_of(const Entry& entry, std::true_type /* map */) noexcept
+    {
+        return std::get<0>(entry);
+    }
+
+    template <typename Entry>
+    static void insert(Container& container, Entry&& entry, std::false_type /* container entry */)
+    {
+        container.insert(std::forward<Entry>(entry));
+    }
+
+    template <typename Entry>
+    static void insert(Container& container, Entry&& entry, std::true_type /* tuple of a key and a value */)
+    {
+        container.emplace(std::get<0>(std::forward<Entry>(entry)), std::get<1>(std::forward<Entry>(entry)));
+    }
+
+    static Container finish(sharded_unordered<Container>&& result, std::true_type /* merge */)
+    {
+        return std::move(result).merge();
+    }
+
+    static sharded_unordered<Container> finish(sharded_unordered<Container>&& result, std::false_type /* keep shards */)
+    {
+        return std::move(result);
+    }
+
+    partition_t partition;
+    std::vector<shard_t, shard_allocator> shards;
+};
+
+template <template <typename, typename, typename, typename, typename> class Map, bool Merge>
+struct generic_concurrent_unordered_map_collector final
+{
+    explicit generic_concurrent_unordered_map_collector(const size_t shardCount) noexcept
+        : shardCount(shardCount)
+    {
+    }
+
+    generic_concurrent_unordered_map_collector(generic_concurrent_unordered_map_collector&&) noexcept = default;
+
+    generic_concurrent_unordered_map_collector(const generic_concurrent_unordered_map_collector&) = delete;
+    generic_concurrent_unordered_map_collector& operator= (const generic_concurrent_unordered_map_collector&) = delete;
+
+    template <typename T, typename = std::enable_if_t<is_any_pair_v<T>>>
+    auto builder(type_t<T>)
+    {
+        using first_t = std::tuple_element_t<0, T>;
+        using second_t = std::tuple_element_t<1, T>;
+        using map_t = Map<first_t, second_t, std::hash<first_t>, std::equal_to<first_t>, std::allocator<std::pair<const first_t, second_t>>>;
+
+        return concurrent_unordered_builder<map_t, Merge>(shardCount);
+    }
+
+    size_t shardCount;
+};
+
+template <template <typename, typename, typename, typename> class Set, bool Merge>
+struct generic_concurrent_unordered_set_collector final
+{
+    explicit generic_concurrent_unordered_set_collector(const size_t shardCount) noexcept
+        : shardCount(shardCount)
+    {
+    }
+
+    generic_concurrent_unordered_set_collector(generic_concurrent_unordered_set_collector&&) noexcept = default;
+
+    generic_concurrent_unordered_set_collector(const generic_concurrent_unordered_set_collector&) = delete;
+    generic_concurrent_unordered_set_collector& operator= (const generic_concurrent_unordered_set_collector&) = delete;
+
+    template <typename T>
+    auto builder(type_t<T>)
+    {
+        return concurrent_unordered_builder<Set<T, std::hash<T>, std::equal_to<T>, std::allocator<T>>, Merge>(shardCount);
+    }
+
+    size_t shardCount;
+};
+
+inline auto to_concurrent_unordered_map(const size_t shardCount = detail::concurrent::default_shard_count()) noexcept
+{
+    return generic_concurrent_unordered_map_collector<std::unordered_map, true>(shardCount);
+}
+
+inline auto to_concurrent_unordered_multimap(const size_t shardCount = detail::concurrent::default_shard_count()) noexcept
+{
+    return generic_concurrent_unordered_map_collector<std::unordered_multimap, true>(shardCount);
+}
+
+inline auto to_concurrent_unordered_set(const size_t shardCount = detail::concurrent::default_shard_count()) noexcept
+{
+    return generic_concurrent_unordered_set_collector<std::unordered_set, true>(shardCount);
+}
+
+inline auto to_concurrent_unordered_multiset(const size_t shardCount = detail::concurrent::default_shard_count()) noexcept
+{
+    return generic_concurrent_unordered_set_collector<std::unordered_multiset, true>(shardCount);
+}
+
+inline auto to_sharded_unordered_map(const size_t shardCount = detail::concurrent::default_shard_count()) noexcept
+{
+    return generic_concurrent_unordered_map_collector<std::unordered_map, false>(shardCount);
+}
+
+inline auto to_sharded_unordered_set(const size_t shardCount = detail::concurrent::default_shard_count()) noexcept
+{
+    return generic_concurrent_unordered_set_collector<std::unordered_set, false>(shardCount);
+}
+
+} // exstream namespace
@@ -4,6 +4,7 @@
 #include "utility.hpp"
 
 EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <iterator>
 #include <type_traits>
 EXSTREAM_RESTORE_ALL_WARNINGS
 
@@ -31,11 +32,16 @@ public:
 
     explicit forward_list_builder(list_t&& list)
         : list(std::move(list)),
-          last(list.before_begin())
+          last(find_last(this->list))
     {
     }
 
-    forward_list_builder(forward_list_builder&&) = default;
+    // NOTE: the before begin iterator points into the list object, so it isn't moved with the nodes
+    forward_list_builder(forward_list_builder&& that)
+        : list(std::move(that.list)),
+          last((that.last == that.list.before_begin()) ? list.before_begin() : that.last)
+    {
+    }
 
     forward_list_builder(const forward_list_builder&) = delete;
     forward_list_builder& operator= (const forward_list_builder&) = delete;
@@ -54,6 +60,16 @@ public:
         last = list.insert_after(last, std::move(value));
     }
 
+    void combine(forward_list_builder&& that)
+    {
+        if (that.list.empty()) return;
+
+        const auto thatLast = that.last;
+        list.splice_after(last, std::move(that.list));
+        last = thatLast;
+        that.last = that.list.before_begin();
+    }
+
     list_t build()
     {
         return std::move(list);
@@ -61,6 +77,15 @@ public:
 
 private:
 
+    static iterator_t find_last(list_t& list) noexcept
+    {
+        auto result = list.before_begin();
+        for (auto next = std::next(result); next != list.end(); ++next)
+            result = next;
+
+        return result;
+    }
+
     list_t list;
     iterator_t last;
 };
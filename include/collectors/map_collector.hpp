@@ -18,7 +18,7 @@ template <typename Key,
           typename Value,
           template <typename, typename, typename, typename> class Map,
           typename Compare = std::less<Key>,
-          typename Allocator = std::allocator<std::pair<Key, Value>>>
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
 class map_builder final
 {
     using map_t = Map<Key, Value, Compare, Allocator>;
@@ -60,6 +60,13 @@ public:
         map.insert(std::make_pair(std::get<0>(std::move(entry)), std::get<1>(std::move(entry))));
     }
 
+    // NOTE: moves the entries of the following chunk, a duplicate key keeps the value of the earlier chunk
+    void combine(map_builder&& that)
+    {
+        map.insert(std::make_move_iterator(that.map.begin()), std::make_move_iterator(that.map.end()));
+        that.map.clear();
+    }
+
     map_t build()
     {
         return std::move(map);
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "config.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <exception>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+// NOTE: what the fixed capacity collectors do with the elements past their capacity
+enum class Overflow
+{
+    Throw,   // throw capacity_overflow, before consuming the stream if its count is known
+    Truncate // drop the elements past the capacity
+};
+
+class capacity_overflow : public std::exception {};
+
+namespace detail {
+namespace overflow {
+
+// NOTE: returns false if the element should be dropped
+inline bool check(const Overflow policy, const size_t size, const size_t capacity)
+{
+    if (size < capacity) return true;
+    if (policy == Overflow::Throw) throw capacity_overflow();
+    return false;
+}
+
+}} // detail::overflow namespace
+} // exstream namespace
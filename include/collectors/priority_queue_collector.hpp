@@ -1,5 +1,6 @@
 #pragma once
 
+#include "adaptor_collector.hpp"
 #include "detail/traits.hpp"
 
 namespace std {
@@ -14,6 +15,7 @@ class priority_queue;
 
 namespace exstream {
 
+// NOTE: the elements are appended to a container and pushed to the queue at build, so the builders combine by moving the elements
 template <typename T,
           typename Container,
           typename Compare>
@@ -25,7 +27,8 @@ public:
     priority_queue_builder() = default;
 
     explicit priority_queue_builder(queue_t&& queue)
-        : queue(std::move(queue))
+        : queue(std::move(queue)),
+          container()
     {
     }
 
@@ -40,22 +43,36 @@ public:
 
     void append(const T& value)
     {
-        queue.push(value);
+        container.push_back(value);
     }
 
     void append(T&& value)
     {
-        queue.push(std::move(value));
+        container.push_back(std::move(value));
+    }
+
+    void combine(priority_queue_builder&& that)
+    {
+        assert(that.queue.empty() && "Only the first builder may have the initial elements");
+
+        container.insert(container.end(), std::make_move_iterator(that.container.begin()), std::make_move_iterator(that.container.end()));
+        that.container.clear();
     }
 
+    // NOTE: the elements are pushed to keep the comparator of the initial queue
     queue_t build()
     {
+        for (auto& value : container)
+            queue.push(std::move(value));
+
+        container.clear();
         return std::move(queue);
     }
 
 private:
 
     queue_t queue;
+    Container container;
 };
 
 struct generic_priority_queue_collector final
@@ -2,8 +2,24 @@
 
 #include "detail/constexpr_if.hpp"
 #include "detail/traits.hpp"
+#include "detail/scope_guard.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
 
 namespace exstream {
+namespace detail {
+namespace sequence {
+
+// NOTE: chunks of this total size are moved to the combined vector by several threads
+constexpr size_t parallel_combine_threshold = size_t(1) << 16;
+constexpr size_t max_combine_threads = 8;
+
+}} // detail::sequence namespace
 
 template <typename T,
           typename Allocator,
@@ -45,6 +61,30 @@ public:
         sequence.push_back(std::move(value));
     }
 
+    template <typename InputIter>
+    void append_range(InputIter first, InputIter last)
+    {
+        sequence.insert(std::end(sequence), first, last);
+    }
+
+    // NOTE: appends the elements of the builder of the following chunk
+    void combine(sequence_builder&& that)
+    {
+        combine(std::move(that), detail::has_splice_method<sequence_t&, typename sequence_t::const_iterator, sequence_t&&>());
+    }
+
+    // NOTE: appends the elements of the builders of the following chunks in their order. The vector is resized once,
+    //       every chunk is moved to its offset (the prefix sum of the chunk sizes) and large chunks are moved in parallel
+    template <typename BuilderIter>
+    void combine(BuilderIter first, BuilderIter last)
+    {
+        using is_contiguous = std::bool_constant<std::is_same_v<sequence_t, std::vector<T, Allocator>> &&
+                                                 std::is_default_constructible_v<T> &&
+                                                 std::is_nothrow_move_assignable_v<T>>;
+
+        combine(first, last, is_contiguous());
+    }
+
     sequence_t build() noexcept(std::is_nothrow_move_constructible_v<sequence_t>)
     {
         return std::move(sequence);
@@ -52,6 +92,81 @@ public:
 
 private:
 
+    void combine(sequence_builder&& that, std::true_type /* splice */)
+    {
+        sequence.splice(std::cend(sequence), std::move(that.sequence));
+    }
+
+    void combine(sequence_builder&& that, std::false_type /* move elements */)
+    {
+        sequence.insert(std::end(sequence), std::make_move_iterator(std::begin(that.sequence)), std::make_move_iterator(std::end(that.sequence)));
+        that.sequence.clear();
+    }
+
+    template <typename BuilderIter>
+    void combine(BuilderIter first, BuilderIter last, std::false_type /* fold */)
+    {
+        for (; first != last; ++first)
+            combine(std::move(*first));
+    }
+
+    template <typename BuilderIter>
+    void combine(BuilderIter first, BuilderIter last, std::true_type /* contiguous */)
+    {
+        const auto chunks = size_t(std::distance(first, last));
+        if (chunks == 0) return;
+
+        std::vector<size_t> offsets;
+        offsets.reserve(chunks);
+
+        auto total = sequence.size();
+        for (auto iter = first; iter != last; ++iter)
+        {
+            offsets.push_back(total);
+            total += iter->sequence.size();
+        }
+
+        sequence.resize(total);
+
+        const auto place = [&](const size_t chunk) noexcept
+        {
+            auto& source = first[chunk].sequence;
+            std::move(std::begin(source), std::end(source), std::begin(sequence) + offsets[chunk]);
+            source.clear();
+        };
+
+        const auto threads = std::min({ chunks, size_t(std::thread::hardware_concurrency()), detail::sequence::max_combine_threads });
+        if (threads < 2 || total - offsets.front() < detail::sequence::parallel_combine_threshold)
+        {
+            for (size_t chunk = 0; chunk < chunks; ++chunk)
+                place(chunk);
+
+            return;
+        }
+
+        // NOTE: the chunks are written to disjoint ranges of the resized vector, so the threads don't synchronize
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+
+        EXSTREAM_SCOPE_EXIT noexcept
+        {
+            for (auto& worker : workers)
+                worker.join();
+        };
+
+        for (size_t worker = 1; worker < threads; ++worker)
+        {
+            workers.emplace_back([&, worker]() noexcept
+            {
+                for (auto chunk = worker; chunk < chunks; chunk += threads)
+                    place(chunk);
+            });
+        }
+
+        for (size_t chunk = 0; chunk < chunks; chunk += threads)
+            place(chunk);
+    }
+
     sequence_t sequence;
 };
 
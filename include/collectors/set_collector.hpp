@@ -4,6 +4,7 @@
 #include "utility.hpp"
 
 EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <iterator>
 #include <type_traits>
 EXSTREAM_RESTORE_ALL_WARNINGS
 
@@ -57,6 +58,12 @@ public:
         set.insert(std::move(value));
     }
 
+    void combine(set_builder&& that)
+    {
+        set.insert(std::make_move_iterator(that.set.begin()), std::make_move_iterator(that.set.end()));
+        that.set.clear();
+    }
+
     set_t build()
     {
         return std::move(set);
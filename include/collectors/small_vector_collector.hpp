@@ -0,0 +1,98 @@
+#pragma once
+
+#include "small_vector.hpp"
+#include "detail/traits.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <iterator>
+#include <memory>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+template <typename T, size_t N, typename Allocator>
+class small_vector_builder final
+{
+    using vector_t = small_vector<T, N, Allocator>;
+public:
+
+    explicit small_vector_builder(const Allocator& alloc) noexcept
+        : vector(alloc)
+    {
+    }
+
+    small_vector_builder(const small_vector_builder&) = delete;
+    small_vector_builder(small_vector_builder&&) = default;
+
+    small_vector_builder& operator= (const small_vector_builder&) = delete;
+    small_vector_builder& operator= (small_vector_builder&&) = delete;
+
+    // NOTE: allocates exactly the known count if it doesn't fit the inline storage
+    void reserve(const size_t size)
+    {
+        vector.reserve(size);
+    }
+
+    void append(const T& value)
+    {
+        vector.push_back(value);
+    }
+
+    void append(T&& value)
+    {
+        vector.push_back(std::move(value));
+    }
+
+    template <typename InputIter>
+    void append_range(InputIter first, InputIter last)
+    {
+        vector.append(first, last);
+    }
+
+    void combine(small_vector_builder&& that)
+    {
+        vector.append(std::make_move_iterator(that.vector.begin()), std::make_move_iterator(that.vector.end()));
+        that.vector.clear();
+    }
+
+    vector_t build() noexcept(std::is_nothrow_move_constructible_v<vector_t>)
+    {
+        return std::move(vector);
+    }
+
+private:
+
+    vector_t vector;
+};
+
+// NOTE: collects into the inline storage of N elements, the larger results are allocated by the stream allocator
+template <size_t N>
+struct small_vector_collector final
+{
+    small_vector_collector() noexcept = default;
+    small_vector_collector(small_vector_collector&&) noexcept = default;
+
+    small_vector_collector(const small_vector_collector&) = delete;
+    small_vector_collector& operator= (const small_vector_collector&) = delete;
+
+    template <typename T>
+    auto builder(type_t<T>) const noexcept
+    {
+        return small_vector_builder<T, N, std::allocator<T>>(std::allocator<T>());
+    }
+
+    template <typename T, typename Allocator>
+    auto builder(type_t<T>, const Allocator& alloc) const noexcept
+    {
+        using allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+        return small_vector_builder<T, N, allocator>(allocator(alloc));
+    }
+};
+
+template <size_t N>
+auto to_small_vector() noexcept
+{
+    return small_vector_collector<N>();
+}
+
+} // exstream namespace
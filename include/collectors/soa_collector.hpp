@@ -0,0 +1,148 @@
+#pragma once
+
+#include "detail/constexpr_if.hpp"
+#include "detail/traits.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+namespace soa {
+
+template <typename T, typename AlwaysVoid = std::void_t<>>
+struct is_tuple_like : std::false_type {};
+
+template <typename T>
+struct is_tuple_like<T, std::void_t<decltype(std::tuple_size<T>::value)>> : std::true_type {};
+
+template <typename T, typename Allocator, typename Indices = std::make_index_sequence<std::tuple_size_v<T>>>
+struct columns;
+
+template <typename T, typename Allocator, size_t... Indices>
+struct columns<T, Allocator, std::index_sequence<Indices...>> final
+{
+    template <size_t Index>
+    using element_t = std::tuple_element_t<Index, T>;
+
+    template <size_t Index>
+    using column_t = std::vector<element_t<Index>, typename std::allocator_traits<Allocator>::template rebind_alloc<element_t<Index>>>;
+
+    using type = std::tuple<column_t<Indices>...>;
+};
+
+}} // detail::soa namespace
+
+// NOTE: every tuple-like element (std::tuple, std::pair, std::array or a type with the tuple protocol) is stored field by field
+template <typename T, typename Allocator>
+using columns_t = typename detail::soa::columns<T, Allocator>::type;
+
+template <typename T,
+          typename Allocator>
+class soa_builder final
+{
+    using columns_type = columns_t<T, Allocator>;
+    using indices = std::make_index_sequence<std::tuple_size_v<T>>;
+public:
+
+    soa_builder() = default;
+
+    explicit soa_builder(columns_type&& columns) noexcept(std::is_nothrow_move_constructible_v<columns_type>)
+        : columns(std::move(columns))
+    {
+    }
+
+    soa_builder(const soa_builder&) = delete;
+    soa_builder(soa_builder&&) = default;
+
+    soa_builder& operator= (const soa_builder&) = delete;
+    soa_builder& operator= (soa_builder&&) = delete;
+
+    void reserve(const size_t size)
+    {
+        reserve(size, indices());
+    }
+
+    void append(const T& value)
+    {
+        append(value, indices());
+    }
+
+    void append(T&& value)
+    {
+        append(std::move(value), indices());
+    }
+
+    void combine(soa_builder&& that)
+    {
+        combine(std::move(that), indices());
+    }
+
+    columns_type build() noexcept(std::is_nothrow_move_constructible_v<columns_type>)
+    {
+        return std::move(columns);
+    }
+
+private:
+
+    template <size_t... Indices>
+    void reserve(const size_t size, std::index_sequence<Indices...>)
+    {
+        (void)std::initializer_list<int>{ (void(std::get<Indices>(columns).reserve(size)), 0)... };
+    }
+
+    template <size_t... Indices>
+    void combine(soa_builder&& that, std::index_sequence<Indices...>)
+    {
+        (void)std::initializer_list<int>{ (void(std::get<Indices>(columns).insert(std::get<Indices>(columns).end(),
+                                                                                  std::make_move_iterator(std::get<Indices>(that.columns).begin()),
+                                                                                  std::make_move_iterator(std::get<Indices>(that.columns).end()))), 0)... };
+        (void)std::initializer_list<int>{ (void(std::get<Indices>(that.columns).clear()), 0)... };
+    }
+
+    template <typename U, size_t... Indices>
+    void append(U&& value, std::index_sequence<Indices...>)
+    {
+        using std::get;
+        (void)std::initializer_list<int>{ (void(std::get<Indices>(columns).push_back(get<Indices>(std::forward<U>(value)))), 0)... };
+    }
+
+    columns_type columns;
+};
+
+struct soa_collector final
+{
+    soa_collector() noexcept = default;
+    soa_collector(soa_collector&&) noexcept = default;
+
+    soa_collector(const soa_collector&) = delete;
+    soa_collector& operator= (const soa_collector&) = delete;
+
+    template <typename T>
+    auto builder(type_t<T>) noexcept
+    {
+        return constexpr_if<detail::soa::is_tuple_like<T>::value>()
+            .then([](auto type) noexcept
+            {
+                using element_t = typename decltype(type)::type;
+                return soa_builder<element_t, std::allocator<element_t>>();
+            })
+            .else_([](auto) noexcept
+            {
+                static_assert(false, "Columns collector requires tuple-like elements");
+                return 0;
+            })(type_t<T>());
+    }
+};
+
+inline auto to_columns() noexcept
+{
+    return soa_collector();
+}
+
+} // exstream namespace
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "overflow_policy.hpp"
+#include "static_vector.hpp"
+#include "detail/traits.hpp"
+
+namespace exstream {
+
+template <typename T, size_t N>
+class static_vector_builder final
+{
+public:
+
+    explicit static_vector_builder(const Overflow policy) noexcept
+        : vector(),
+          policy(policy)
+    {
+    }
+
+    static_vector_builder(const static_vector_builder&) = delete;
+    static_vector_builder(static_vector_builder&&) = default;
+
+    static_vector_builder& operator= (const static_vector_builder&) = delete;
+    static_vector_builder& operator= (static_vector_builder&&) = delete;
+
+    void reserve(const size_t size)
+    {
+        if (size > N && policy == Overflow::Throw) throw capacity_overflow();
+    }
+
+    void append(const T& value)
+    {
+        if (detail::overflow::check(policy, vector.size(), N))
+            vector.push_back(value);
+    }
+
+    void append(T&& value)
+    {
+        if (detail::overflow::check(policy, vector.size(), N))
+            vector.push_back(std::move(value));
+    }
+
+    void combine(static_vector_builder&& that)
+    {
+        for (auto& value : that.vector)
+            append(std::move(value));
+
+        that.vector.clear();
+    }
+
+    static_vector<T, N> build() noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        return std::move(vector);
+    }
+
+private:
+
+    static_vector<T, N> vector;
+    Overflow policy;
+};
+
+// NOTE: collects up to N elements without the heap allocations
+template <size_t N>
+struct static_vector_collector final
+{
+    explicit static_vector_collector(const Overflow policy = Overflow::Throw) noexcept
+        : policy(policy)
+    {
+    }
+
+    static_vector_collector(static_vector_collector&&) noexcept = default;
+
+    static_vector_collector(const static_vector_collector&) = delete;
+    static_vector_collector& operator= (const static_vector_collector&) = delete;
+
+    template <typename T>
+    auto builder(type_t<T>) const noexcept
+    {
+        return static_vector_builder<T, N>(policy);
+    }
+
+    Overflow policy;
+};
+
+template <size_t N>
+auto to_static_vector(const Overflow policy = Overflow::Throw) noexcept
+{
+    return static_vector_collector<N>(policy);
+}
+
+} // exstream namespace
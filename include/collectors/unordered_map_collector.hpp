@@ -70,6 +70,13 @@ public:
         map.insert(std::make_pair(std::get<0>(std::move(entry)), std::get<1>(std::move(entry))));
     }
 
+    void combine(unordered_map_builder&& that)
+    {
+        map.reserve(map.size() + that.map.size());
+        map.insert(std::make_move_iterator(that.map.begin()), std::make_move_iterator(that.map.end()));
+        that.map.clear();
+    }
+
     map_t build()
     {
         return std::move(map);
@@ -95,7 +102,7 @@ struct generic_unordered_map_collector final
         using first_t = std::tuple_element_t<0, T>;
         using second_t = std::tuple_element_t<1, T>;
 
-        return unordered_map_builder<first_t, second_t, std::hash<T>, std::less<T>, std::allocator<T>, Map>();
+        return unordered_map_builder<first_t, second_t, std::hash<first_t>, std::equal_to<first_t>, std::allocator<std::pair<const first_t, second_t>>, Map>();
     }
 };
 
@@ -4,6 +4,7 @@
 #include "utility.hpp"
 
 EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <iterator>
 #include <type_traits>
 EXSTREAM_RESTORE_ALL_WARNINGS
 
@@ -65,6 +66,13 @@ public:
         set.insert(std::move(key));
     }
 
+    void combine(unordered_set_builder&& that)
+    {
+        set.reserve(set.size() + that.set.size());
+        set.insert(std::make_move_iterator(that.set.begin()), std::make_move_iterator(that.set.end()));
+        that.set.clear();
+    }
+
     set_t build()
     {
         return std::move(set);
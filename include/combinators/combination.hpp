@@ -0,0 +1,89 @@
+#pragma once
+
+#include "transformations/transformation.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <tuple>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+// NOTE: a stream over several sources, sources are referenced like the transformations reference theirs,
+//       the function is copied, so combinators may pass a small object of references (e.g. several keys),
+//       combinations without a function use nothing_t
+template <typename T,
+          typename CombineIterator,
+          typename Allocator,
+          typename Meta,
+          typename Function,
+          typename... Sources>
+class combination final : public with_transformations<T, combination<T, CombineIterator, Allocator, Meta, Function, Sources...>>,
+                          public terminator<T, combination<T, CombineIterator, Allocator, Meta, Function, Sources...>>
+{
+    using indices = std::index_sequence_for<Sources...>;
+public:
+
+    using iterator_type = CombineIterator;
+    using allocator = Allocator;
+    using meta = Meta;
+
+    explicit combination(const Allocator& alloc, const Function& function, const Sources&... sources) noexcept
+        : sources(sources...),
+          function(function),
+          alloc(alloc)
+    {
+    }
+
+    combination(combination&&) = default;
+
+    combination(const combination&) = delete;
+    combination& operator= (const combination&) = delete;
+
+    CombineIterator get_iterator() const
+    {
+        return get_iterator(indices(), std::is_same<Function, nothing_t>());
+    }
+
+    const Allocator& get_allocator() const noexcept
+    {
+        return alloc;
+    }
+
+private:
+
+    template <size_t... Indices>
+    CombineIterator get_iterator(std::index_sequence<Indices...>, std::true_type /* is nothing */) const
+    {
+        return CombineIterator(std::get<Indices>(sources).get_iterator()...);
+    }
+
+    template <size_t... Indices>
+    CombineIterator get_iterator(std::index_sequence<Indices...>, std::false_type /* is nothing */) const
+    {
+        return CombineIterator(std::get<Indices>(sources).get_iterator()..., function, get_allocator());
+    }
+
+    std::tuple<const Sources&...> sources;
+    Function function;
+    const Allocator& alloc;
+};
+
+namespace detail {
+
+template <typename CombineIterator, typename Meta, typename Function, typename Source, typename... Sources>
+auto make_function_combination(const Function& function, const Source& source, const Sources&... sources) noexcept
+{
+    using value_type = typename CombineIterator::value_type;
+    using allocator = typename Source::allocator;
+
+    return combination<value_type, CombineIterator, allocator, Meta, Function, Source, Sources...>(source.get_allocator(), function, source, sources...);
+}
+
+template <typename CombineIterator, typename Meta, typename Source, typename... Sources>
+auto make_combination(const Source& source, const Sources&... sources) noexcept
+{
+    return make_function_combination<CombineIterator, Meta>(nothing, source, sources...);
+}
+
+} // detail namespace
+} // exstream namespace
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "combination.hpp"
+#include "zip_iterator.hpp"
+#include "concat_iterator.hpp"
+#include "merge_iterator.hpp"
+#include "merge_join_iterator.hpp"
+#include "hash_join_iterator.hpp"
+#include "meta_info.hpp"
+
+namespace exstream {
+namespace detail {
+namespace combine {
+
+// NOTE: tuples are compared lexicographically, so only a strictly ordered first source orders the zip
+template <typename FirstMeta, typename... Metas>
+struct zip_meta final
+{
+    static constexpr bool is_ordered = FirstMeta::is_ordered && FirstMeta::is_distinct;
+    static constexpr bool is_distinct = FirstMeta::is_distinct || std::disjunction_v<std::bool_constant<Metas::is_distinct>...>;
+
+    using type = meta_info<is_ordered, is_distinct, is_ordered ? FirstMeta::order : Order::Unknown>;
+};
+
+// NOTE: order of the sources asserted to be sorted, sources of unknown order are treated as ascending
+template <typename FirstMeta, typename SecondMeta>
+struct sorted_order final
+{
+    static_assert(!(FirstMeta::is_ordered && SecondMeta::is_ordered) || FirstMeta::order == SecondMeta::order,
+                  "Combined streams are ordered in different directions");
+
+    static constexpr Order value = FirstMeta::is_ordered  ? FirstMeta::order  :
+                                   SecondMeta::is_ordered ? SecondMeta::order :
+                                                            Order::Ascending;
+};
+
+template <typename FirstMeta, typename SecondMeta>
+struct merge_order final
+{
+    static_assert(FirstMeta::is_ordered && SecondMeta::is_ordered,
+                  "Merged streams should be ordered, use assume_sorted if the order can't be inferred");
+
+    static constexpr Order value = sorted_order<FirstMeta, SecondMeta>::value;
+};
+
+template <typename FirstMeta, typename SecondMeta>
+struct sorted_concat_meta final
+{
+    // NOTE: the caller guarantees the first stream elements precede the second stream elements, so the ranges are disjoint
+    using type = meta_info<true, FirstMeta::is_distinct && SecondMeta::is_distinct, sorted_order<FirstMeta, SecondMeta>::value>;
+};
+
+template <typename Source>
+using iterator_t = typename Source::iterator_type;
+
+template <typename Policy, Order AnOrder, typename First, typename Second>
+auto merge(const First& first, const Second& second) noexcept
+{
+    using iterator_type = merge_iterator<iterator_t<First>, iterator_t<Second>, order_compare_t<AnOrder>, Policy>;
+    using meta = meta_info<true, Policy::is_distinct(First::meta::is_distinct, Second::meta::is_distinct), AnOrder>;
+
+    return make_combination<iterator_type, meta>(first, second);
+}
+
+template <Order AnOrder, typename First, typename Second, typename Key>
+auto merge_join(const First& first, const Second& second, const Key& key) noexcept
+{
+    using allocator = typename First::allocator;
+    using iterator_type = merge_join_iterator<iterator_t<First>, iterator_t<Second>, Key, order_compare_t<AnOrder>, allocator>;
+    using meta = meta_info<true, First::meta::is_distinct && Second::meta::is_distinct, AnOrder>;
+
+    return make_function_combination<iterator_type, meta>(key, first, second);
+}
+
+template <template <typename, typename, typename, typename, bool> class JoinIterator, bool Flag, typename Meta,
+          typename Probe, typename Build, typename ProbeKey, typename BuildKey>
+auto hash_join(const Probe& probe, const Build& build, const ProbeKey& probeKey, const BuildKey& buildKey) noexcept
+{
+    using allocator = typename Probe::allocator;
+    using keys = join_keys<ProbeKey, BuildKey>;
+    using iterator_type = JoinIterator<iterator_t<Probe>, iterator_t<Build>, keys, allocator, Flag>;
+
+    return make_function_combination<iterator_type, Meta>(keys{ probeKey, buildKey }, probe, build);
+}
+
+template <typename First, typename Second>
+constexpr Order merge_order_v = merge_order<typename First::meta, typename Second::meta>::value;
+
+template <typename First, typename Second>
+constexpr Order sorted_order_v = sorted_order<typename First::meta, typename Second::meta>::value;
+
+}} // detail::combine namespace
+
+template <typename Source, typename... Sources>
+auto zip(const Source& source, const Sources&... sources) noexcept
+{
+    using iterator_type = zip_iterator<detail::combine::iterator_t<Source>, detail::combine::iterator_t<Sources>...>;
+    using meta = typename detail::combine::zip_meta<typename Source::meta, typename Sources::meta...>::type;
+
+    return detail::make_combination<iterator_type, meta>(source, sources...);
+}
+
+template <typename First, typename Second>
+auto concat(const First& first, const Second& second) noexcept
+{
+    using iterator_type = concat_iterator<detail::combine::iterator_t<First>, detail::combine::iterator_t<Second>>;
+    using meta = meta_info<false, false, Order::Unknown>;
+
+    return detail::make_combination<iterator_type, meta>(first, second);
+}
+
+template <typename First, typename Second>
+auto concat(assume_sorted_t, const First& first, const Second& second) noexcept
+{
+    using iterator_type = concat_iterator<detail::combine::iterator_t<First>, detail::combine::iterator_t<Second>>;
+    using meta = typename detail::combine::sorted_concat_meta<typename First::meta, typename Second::meta>::type;
+
+    return detail::make_combination<iterator_type, meta>(first, second);
+}
+
+// NOTE: merges two streams ordered in the same direction in a single pass, elements of the first stream go first on ties
+template <typename First, typename Second>
+auto merge(const First& first, const Second& second) noexcept
+{
+    return detail::combine::merge<detail::combine::merge_policy, detail::combine::merge_order_v<First, Second>>(first, second);
+}
+
+template <typename First, typename Second>
+auto merge(assume_sorted_t, const First& first, const Second& second) noexcept
+{
+    return detail::combine::merge<detail::combine::merge_policy, detail::combine::sorted_order_v<First, Second>>(first, second);
+}
+
+template <typename First, typename Second>
+auto set_union(const First& first, const Second& second) noexcept
+{
+    return detail::combine::merge<detail::combine::union_policy, detail::combine::merge_order_v<First, Second>>(first, second);
+}
+
+template <typename First, typename Second>
+auto set_union(assume_sorted_t, const First& first, const Second& second) noexcept
+{
+    return detail::combine::merge<detail::combine::union_policy, detail::combine::sorted_order_v<First, Second>>(first, second);
+}
+
+template <typename First, typename Second>
+auto set_intersection(const First& first, const Second& second) noexcept
+{
+    return detail::combine::merge<detail::combine::intersection_policy, detail::combine::merge_order_v<First, Second>>(first, second);
+}
+
+template <typename First, typename Second>
+auto set_intersection(assume_sorted_t, const First& first, const Second& second) noexcept
+{
+    return detail::combine::merge<detail::combine::intersection_policy, detail::combine::sorted_order_v<First, Second>>(first, second);
+}
+
+template <typename First, typename Second>
+auto set_difference(const First& first, const Second& second) noexcept
+{
+    return detail::combine::merge<detail::combine::difference_policy, detail::combine::merge_order_v<First, Second>>(first, second);
+}
+
+template <typename First, typename Second>
+auto set_difference(assume_sorted_t, const First& first, const Second& second) noexcept
+{
+    return detail::combine::merge<detail::combine::difference_policy, detail::combine::sorted_order_v<First, Second>>(first, second);
+}
+
+// NOTE: pairs the elements with equal keys, both streams should be ordered by the key
+template <typename First, typename Second, typename Key>
+auto merge_join(const First& first, const Second& second, const Key& key) noexcept
+{
+    return detail::combine::merge_join<detail::combine::merge_order_v<First, Second>>(first, second, key);
+}
+
+template <typename First, typename Second, typename Key>
+auto merge_join(assume_sorted_t, const First& first, const Second& second, const Key& key) noexcept
+{
+    return detail::combine::merge_join<detail::combine::sorted_order_v<First, Second>>(first, second, key);
+}
+
+// NOTE: the build stream is collected into a hash table once, then the probe stream is streamed through it,
+//       pairs every probe element with every build element of the same key
+template <typename Probe, typename Build, typename ProbeKey, typename BuildKey>
+auto hash_join(const Probe& probe, const Build& build, const ProbeKey& probeKey, const BuildKey& buildKey) noexcept
+{
+    using meta = meta_info<false, false, Order::Unknown>;
+    return detail::combine::hash_join<hash_join_iterator, false, meta>(probe, build, probeKey, buildKey);
+}
+
+// NOTE: like hash_join, but every unmatched probe element is paired with an empty option
+template <typename Probe, typename Build, typename ProbeKey, typename BuildKey>
+auto left_hash_join(const Probe& probe, const Build& build, const ProbeKey& probeKey, const BuildKey& buildKey) noexcept
+{
+    using meta = meta_info<false, false, Order::Unknown>;
+    return detail::combine::hash_join<hash_join_iterator, true, meta>(probe, build, probeKey, buildKey);
+}
+
+// NOTE: keeps the probe elements having a build element of the same key, the probe stream order is kept
+template <typename Probe, typename Build, typename ProbeKey, typename BuildKey>
+auto semi_hash_join(const Probe& probe, const Build& build, const ProbeKey& probeKey, const BuildKey& buildKey) noexcept
+{
+    return detail::combine::hash_join<hash_semi_join_iterator, false, typename Probe::meta>(probe, build, probeKey, buildKey);
+}
+
+// NOTE: keeps the probe elements without a build element of the same key, the probe stream order is kept
+template <typename Probe, typename Build, typename ProbeKey, typename BuildKey>
+auto anti_hash_join(const Probe& probe, const Build& build, const ProbeKey& probeKey, const BuildKey& buildKey) noexcept
+{
+    return detail::combine::hash_join<hash_semi_join_iterator, true, typename Probe::meta>(probe, build, probeKey, buildKey);
+}
+
+} // exstream namespace
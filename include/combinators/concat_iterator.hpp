@@ -0,0 +1,97 @@
+#pragma once
+
+#include "detail/consume.hpp"
+#include "detail/result_traits.hpp"
+#include "utility.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cassert>
+#include <type_traits>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+namespace combine {
+
+// NOTE: sources with the same result type keep it (e.g. references), otherwise elements are converted to a common value
+template <typename First, typename Second>
+using common_result_t = std::conditional_t<
+    std::is_same_v<First, Second>,
+    First,
+    std::common_type_t<First, Second>
+>;
+
+}} // detail::combine namespace
+
+template <typename First,
+          typename Second>
+class concat_iterator final
+{
+public:
+
+    using result_type = detail::combine::common_result_t<typename First::result_type, typename Second::result_type>;
+    using value_type = typename result_traits<result_type>::value_type;
+
+    explicit concat_iterator(First&& first, Second&& second) noexcept(std::is_nothrow_move_constructible_v<First> &&
+                                                                      std::is_nothrow_move_constructible_v<Second>)
+        : first(std::move(first)),
+          second(std::move(second))
+    {
+    }
+
+    concat_iterator(concat_iterator&&) = default;
+
+    concat_iterator(const concat_iterator&) = delete;
+    concat_iterator& operator= (const concat_iterator&) = delete;
+    concat_iterator& operator= (concat_iterator&&) = delete;
+
+    bool has_next()
+    {
+        return first.has_next() || second.has_next();
+    }
+
+    result_type next()
+    {
+        assert(has_next() && "Iterator is out of range");
+        if (first.has_next()) return first.next();
+        return second.next();
+    }
+
+    void skip()
+    {
+        assert(has_next() && "Iterator is out of range");
+        if (first.has_next()) first.skip();
+        else                  second.skip();
+    }
+
+    size_t elements_count() const
+    {
+        const auto firstCount = first.elements_count();
+        const auto secondCount = second.elements_count();
+
+        if (firstCount == unknown_count || secondCount == unknown_count)
+            return unknown_count;
+
+        return firstCount + secondCount;
+    }
+
+    // NOTE: push mode used by the terminators, both sources are drained one after another
+    template <typename Sink>
+    void drain(Sink&& sink)
+    {
+        auto convert = [&](auto&& value)
+        {
+            sink(static_cast<result_type>(std::forward<decltype(value)>(value)));
+        };
+
+        detail::consume(first, convert);
+        detail::consume(second, convert);
+    }
+
+private:
+
+    First first;
+    Second second;
+};
+
+} // exstream namespace
@@ -0,0 +1,369 @@
+#pragma once
+
+#include "detail/consume.hpp"
+#include "detail/result_traits.hpp"
+#include "detail/scope_guard.hpp"
+#include "option.hpp"
+#include "utility.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+namespace combine {
+
+template <typename ProbeKey, typename BuildKey>
+struct join_keys final
+{
+    using probe_key = ProbeKey;
+    using build_key = BuildKey;
+
+    const ProbeKey& probe;
+    const BuildKey& build;
+};
+
+// NOTE: a flat hash table over the build side, the elements and their hashes are kept in arrays and the buckets
+//       chain the element indices through the links array, so the whole table is a few allocations
+template <typename Iterator, typename Key, typename Allocator>
+class hash_table final
+{
+    using traits = result_traits<typename Iterator::result_type>;
+    using storage = typename traits::storage;
+
+    using storage_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<storage>;
+    using index_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<size_t>;
+public:
+
+    using value_type = typename traits::value_type;
+    using key_type = remove_cvr_t<decltype(std::declval<const Key&>()(std::declval<const value_type&>()))>;
+
+    static constexpr size_t npos = size_t(-1);
+
+    explicit hash_table(Iterator&& source, const Key& key, const Allocator& alloc)
+        : elements(storage_allocator(alloc)),
+          hashes(index_allocator(alloc)),
+          links(index_allocator(alloc)),
+          buckets(index_allocator(alloc)),
+          shift(0),
+          key(key)
+    {
+        const auto count = source.elements_count();
+        if (count != unknown_count)
+        {
+            elements.reserve(count);
+            hashes.reserve(count);
+        }
+
+        detail::consume(source, [this](auto&& value)
+        {
+            elements.emplace_back(std::forward<decltype(value)>(value));
+            hashes.push_back(hash(this->key(elements.back().get_ref())));
+        });
+
+        link();
+    }
+
+    hash_table(hash_table&&) = default;
+
+    hash_table(const hash_table&) = delete;
+    hash_table& operator= (const hash_table&) = delete;
+    hash_table& operator= (hash_table&&) = delete;
+
+    static size_t hash(const key_type& value)
+    {
+        // NOTE: fibonacci hashing spreads identity hashes of integers over the high bits used for the buckets
+        return std::hash<key_type>()(value) * size_t(0x9E3779B97F4A7C15ull >> (64 - std::numeric_limits<size_t>::digits));
+    }
+
+    size_t find(const key_type& value, const size_t valueHash) const
+    {
+        return scan(buckets[valueHash >> shift], value, valueHash);
+    }
+
+    size_t find_next(const size_t index, const key_type& value, const size_t valueHash) const
+    {
+        return scan(links[index], value, valueHash);
+    }
+
+    const value_type& get(const size_t index) const noexcept
+    {
+        return elements[index].get_ref();
+    }
+
+private:
+
+    size_t scan(size_t index, const key_type& value, const size_t valueHash) const
+    {
+        while (index != npos && (hashes[index] != valueHash || !(key(get(index)) == value)))
+            index = links[index];
+
+        return index;
+    }
+
+    void link()
+    {
+        const auto count = elements.size();
+
+        size_t bits = 1;
+        while ((size_t(1) << bits) < count * 2)
+            ++bits;
+
+        shift = size_t(std::numeric_limits<size_t>::digits) - bits;
+        buckets.assign(size_t(1) << bits, npos);
+        links.assign(count, npos);
+
+        // NOTE: elements are linked backwards, so the chains keep the build order
+        for (size_t index = count; index-- > 0;)
+        {
+            const auto bucket = hashes[index] >> shift;
+            links[index] = buckets[bucket];
+            buckets[bucket] = index;
+        }
+    }
+
+    std::vector<storage, storage_allocator> elements;
+    std::vector<size_t, index_allocator> hashes;
+    std::vector<size_t, index_allocator> links;
+    std::vector<size_t, index_allocator> buckets;
+    size_t shift;
+    const Key& key;
+};
+
+template <typename Build, typename Keys, typename Allocator>
+using join_table_t = hash_table<Build, typename Keys::build_key, Allocator>;
+
+}} // detail::combine namespace
+
+// NOTE: pairs every probe element with every build element of the same key, the left join also emits
+//       the unmatched probe elements with an empty option. The build elements live in the table,
+//       so they are passed by reference while the iterator is alive
+template <typename Probe,
+          typename Build,
+          typename Keys,
+          typename Allocator,
+          bool IsLeft>
+class hash_join_iterator final
+{
+    using table_t = detail::combine::join_table_t<Build, Keys, Allocator>;
+    using probe_traits = result_traits<typename Probe::result_type>;
+    using probe_storage = typename probe_traits::storage;
+    using key_type = typename table_t::key_type;
+    using build_value = typename table_t::value_type;
+
+    static_assert(std::is_same_v<key_type, remove_cvr_t<decltype(std::declval<const typename Keys::probe_key&>()(
+                                               std::declval<const typename probe_traits::value_type&>()))>>,
+                  "Probe and build keys should be of the same type");
+public:
+
+    using result_type = std::pair<
+        decltype(std::declval<const probe_storage&>().copy()),
+        std::conditional_t<IsLeft, option<const build_value&>, const build_value&>
+    >;
+    using value_type = std::pair<
+        typename probe_traits::value_type,
+        std::conditional_t<IsLeft, option<build_value>, build_value>
+    >;
+
+    explicit hash_join_iterator(Probe&& probe, Build&& build, const Keys& keys, const Allocator& alloc)
+        : probe(std::move(probe)),
+          table(std::move(build), keys.build, alloc),
+          cache(),
+          probeKey(),
+          probeHash(0),
+          match(table_t::npos),
+          matched(false),
+          keys(keys)
+    {
+    }
+
+    hash_join_iterator(hash_join_iterator&&) = default;
+
+    hash_join_iterator(const hash_join_iterator&) = delete;
+    hash_join_iterator& operator= (const hash_join_iterator&) = delete;
+    hash_join_iterator& operator= (hash_join_iterator&&) = delete;
+
+    bool has_next()
+    {
+        return fetch();
+    }
+
+    result_type next()
+    {
+        const bool found = fetch();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        matched = true;
+        return make_result(std::bool_constant<IsLeft>());
+    }
+
+    void skip()
+    {
+        const bool found = fetch();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        matched = true;
+        if (match != table_t::npos)
+            match = table.find_next(match, probeKey.get(), probeHash);
+    }
+
+    size_t elements_count() const noexcept
+    {
+        return unknown_count;
+    }
+
+private:
+
+    using match_type = typename result_type::second_type;
+
+    result_type make_result(std::true_type /* is left */)
+    {
+        if (match == table_t::npos)
+            return result_type(cache.get().copy(), match_type());
+
+        return result_type(cache.get().copy(), match_type(take_match()));
+    }
+
+    result_type make_result(std::false_type /* is left */)
+    {
+        return result_type(cache.get().copy(), take_match());
+    }
+
+    const build_value& take_match()
+    {
+        const auto current = match;
+        match = table.find_next(current, probeKey.get(), probeHash);
+        return table.get(current);
+    }
+
+    // NOTE: moves the probe source until the cached element has a match to emit
+    bool fetch()
+    {
+        for (;;)
+        {
+            if (cache.non_empty())
+            {
+                if (match != table_t::npos || (IsLeft && !matched)) return true;
+                cache.reset();
+            }
+
+            if (!probe.has_next()) return false;
+
+            cache.emplace(probe.next());
+            probeKey = keys.probe(cache.get().get_ref());
+            probeHash = table_t::hash(probeKey.get());
+            match = table.find(probeKey.get(), probeHash);
+            matched = false;
+        }
+    }
+
+    Probe probe;
+    table_t table;
+    option<probe_storage> cache;
+    option<key_type> probeKey;
+    size_t probeHash;
+    size_t match;
+    bool matched;
+    Keys keys;
+};
+
+// NOTE: keeps the probe elements which have (or, for the anti join, have not) a build element of the same key
+template <typename Probe,
+          typename Build,
+          typename Keys,
+          typename Allocator,
+          bool IsAnti>
+class hash_semi_join_iterator final
+{
+    using table_t = detail::combine::join_table_t<Build, Keys, Allocator>;
+    using traits = result_traits<typename Probe::result_type>;
+    using storage = typename traits::storage;
+    using key_type = typename table_t::key_type;
+
+    static_assert(std::is_same_v<key_type, remove_cvr_t<decltype(std::declval<const typename Keys::probe_key&>()(
+                                               std::declval<const typename traits::value_type&>()))>>,
+                  "Probe and build keys should be of the same type");
+public:
+
+    using result_type = typename traits::result_type;
+    using value_type = typename traits::value_type;
+
+    explicit hash_semi_join_iterator(Probe&& probe, Build&& build, const Keys& keys, const Allocator& alloc)
+        : probe(std::move(probe)),
+          table(std::move(build), keys.build, alloc),
+          cache(),
+          keys(keys)
+    {
+    }
+
+    hash_semi_join_iterator(hash_semi_join_iterator&&) = default;
+
+    hash_semi_join_iterator(const hash_semi_join_iterator&) = delete;
+    hash_semi_join_iterator& operator= (const hash_semi_join_iterator&) = delete;
+    hash_semi_join_iterator& operator= (hash_semi_join_iterator&&) = delete;
+
+    bool has_next()
+    {
+        return fetch();
+    }
+
+    result_type next()
+    {
+        const bool found = fetch();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        EXSTREAM_SCOPE_SUCCESS noexcept(std::is_nothrow_destructible_v<storage>)
+        {
+            cache.reset();
+        };
+        return cache.get().release();
+    }
+
+    void skip()
+    {
+        const bool found = fetch();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        cache.reset();
+    }
+
+    size_t elements_count() const noexcept
+    {
+        return unknown_count;
+    }
+
+private:
+
+    bool fetch()
+    {
+        while (cache.empty() && probe.has_next())
+        {
+            auto&& value = probe.next();
+            const auto& key = keys.probe(std::as_const(get_lvalue_reference(value)));
+            const bool found = table.find(key, table_t::hash(key)) != table_t::npos;
+
+            if (found != IsAnti)
+                cache.emplace(std::forward<decltype(value)>(value));
+        }
+
+        return cache.non_empty();
+    }
+
+    Probe probe;
+    table_t table;
+    option<storage> cache;
+    Keys keys;
+};
+
+} // exstream namespace
@@ -0,0 +1,303 @@
+#pragma once
+
+#include "concat_iterator.hpp"
+#include "option.hpp"
+#include "detail/scope_guard.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cassert>
+#include <functional>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+namespace combine {
+
+// NOTE: keeps the next element of an ordered source to compare it with the other source
+template <typename Iterator>
+class head final
+{
+    using traits = result_traits<typename Iterator::result_type>;
+public:
+
+    using value_type = typename traits::value_type;
+    using result_type = typename traits::result_type;
+    using storage = typename traits::storage;
+
+    explicit head(Iterator&& iterator) noexcept(std::is_nothrow_move_constructible_v<Iterator>)
+        : iterator(std::move(iterator)),
+          cache()
+    {
+    }
+
+    head(head&&) = default;
+
+    head(const head&) = delete;
+    head& operator= (const head&) = delete;
+    head& operator= (head&&) = delete;
+
+    bool has_value()
+    {
+        if (cache.empty() && iterator.has_next())
+            cache.emplace(iterator.next());
+
+        return cache.non_empty();
+    }
+
+    const value_type& get() const noexcept
+    {
+        assert(cache.non_empty() && "Head is empty");
+        return cache.get().get_ref();
+    }
+
+    decltype(auto) copy() const noexcept(noexcept(std::declval<const storage&>().copy()))
+    {
+        assert(cache.non_empty() && "Head is empty");
+        return cache.get().copy();
+    }
+
+    result_type take()
+    {
+        assert(cache.non_empty() && "Head is empty");
+        EXSTREAM_SCOPE_SUCCESS noexcept(std::is_nothrow_destructible_v<storage>)
+        {
+            cache.reset();
+        };
+        return cache.get().release();
+    }
+
+    storage take_storage()
+    {
+        assert(cache.non_empty() && "Head is empty");
+        EXSTREAM_SCOPE_SUCCESS noexcept(std::is_nothrow_destructible_v<storage>)
+        {
+            cache.reset();
+        };
+        return std::move(cache.get());
+    }
+
+    void drop() noexcept(std::is_nothrow_destructible_v<storage>)
+    {
+        assert(cache.non_empty() && "Head is empty");
+        cache.reset();
+    }
+
+    size_t elements_count() const
+    {
+        const auto count = iterator.elements_count();
+        return (count == unknown_count) ? unknown_count : count + cache.size();
+    }
+
+private:
+
+    Iterator iterator;
+    option<storage> cache;
+};
+
+// NOTE: the comparator of the sources ordered in the same direction
+template <Order AnOrder>
+using order_compare_t = std::conditional_t<AnOrder == Order::Descending, std::greater<>, std::less<>>;
+
+// NOTE: every policy tells which elements are emitted when one head precedes the other or both heads are equal,
+//       a source left alone is handled as if all its elements precede the empty one,
+//       is_distinct tells whether the result of distinct sources is distinct
+struct merge_policy final
+{
+    static constexpr bool emit_first = true;
+    static constexpr bool emit_second = true;
+    static constexpr bool emit_equal = true;
+    static constexpr bool drop_equal_second = false;
+    static constexpr bool exact_count = true;
+
+    static constexpr bool is_distinct(bool, bool) noexcept
+    {
+        return false;
+    }
+};
+
+struct union_policy final
+{
+    static constexpr bool emit_first = true;
+    static constexpr bool emit_second = true;
+    static constexpr bool emit_equal = true;
+    static constexpr bool drop_equal_second = true;
+    static constexpr bool exact_count = false;
+
+    static constexpr bool is_distinct(const bool first, const bool second) noexcept
+    {
+        return first && second;
+    }
+};
+
+struct intersection_policy final
+{
+    static constexpr bool emit_first = false;
+    static constexpr bool emit_second = false;
+    static constexpr bool emit_equal = true;
+    static constexpr bool drop_equal_second = true;
+    static constexpr bool exact_count = false;
+
+    static constexpr bool is_distinct(const bool first, const bool second) noexcept
+    {
+        return first || second;
+    }
+};
+
+struct difference_policy final
+{
+    static constexpr bool emit_first = true;
+    static constexpr bool emit_second = false;
+    static constexpr bool emit_equal = false;
+    static constexpr bool drop_equal_second = true;
+    static constexpr bool exact_count = false;
+
+    static constexpr bool is_distinct(const bool first, bool) noexcept
+    {
+        return first;
+    }
+};
+
+}} // detail::combine namespace
+
+// NOTE: a single pass over two sources ordered with the same Compare, like std::merge and std::set_* algorithms
+template <typename First,
+          typename Second,
+          typename Compare,
+          typename Policy>
+class merge_iterator final
+{
+    using first_head = detail::combine::head<First>;
+    using second_head = detail::combine::head<Second>;
+public:
+
+    using result_type = std::conditional_t<
+        Policy::emit_second,
+        detail::combine::common_result_t<typename First::result_type, typename Second::result_type>,
+        typename First::result_type
+    >;
+    using value_type = typename result_traits<result_type>::value_type;
+
+    explicit merge_iterator(First&& first, Second&& second) noexcept(std::is_nothrow_move_constructible_v<First> &&
+                                                                     std::is_nothrow_move_constructible_v<Second>)
+        : first(std::move(first)),
+          second(std::move(second)),
+          compare(),
+          fromFirst(false)
+    {
+    }
+
+    merge_iterator(merge_iterator&&) = default;
+
+    merge_iterator(const merge_iterator&) = delete;
+    merge_iterator& operator= (const merge_iterator&) = delete;
+    merge_iterator& operator= (merge_iterator&&) = delete;
+
+    bool has_next()
+    {
+        return fetch();
+    }
+
+    result_type next()
+    {
+        const bool found = fetch();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        if (fromFirst) return take_first();
+        return second.take();
+    }
+
+    void skip()
+    {
+        const bool found = fetch();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        if (fromFirst) drop_first();
+        else           second.drop();
+    }
+
+    size_t elements_count() const
+    {
+        return elements_count(std::bool_constant<Policy::exact_count>());
+    }
+
+private:
+
+    // NOTE: moves the heads until one of them has to be emitted, fromFirst tells which one
+    bool fetch()
+    {
+        for (;;)
+        {
+            const bool hasFirst = first.has_value();
+            const bool hasSecond = second.has_value();
+
+            if (!hasFirst && !hasSecond) return false;
+
+            if (!hasSecond || (hasFirst && compare(first.get(), second.get())))
+            {
+                if (Policy::emit_first) return emit(true);
+                if (!hasSecond) return false;
+                first.drop();
+            }
+            else if (!hasFirst || compare(second.get(), first.get()))
+            {
+                if (Policy::emit_second) return emit(false);
+                if (!hasFirst) return false;
+                second.drop();
+            }
+            else
+            {
+                if (Policy::emit_equal) return emit(true);
+                first.drop();
+                second.drop();
+            }
+        }
+    }
+
+    bool emit(const bool isFirst) noexcept
+    {
+        fromFirst = isFirst;
+        return true;
+    }
+
+    bool is_equal_second()
+    {
+        return second.has_value() && !compare(first.get(), second.get()) && !compare(second.get(), first.get());
+    }
+
+    result_type take_first()
+    {
+        if (Policy::drop_equal_second && is_equal_second()) second.drop();
+        return first.take();
+    }
+
+    void drop_first()
+    {
+        if (Policy::drop_equal_second && is_equal_second()) second.drop();
+        first.drop();
+    }
+
+    size_t elements_count(std::true_type /* is exact */) const
+    {
+        const auto firstCount = first.elements_count();
+        const auto secondCount = second.elements_count();
+
+        if (firstCount == unknown_count || secondCount == unknown_count)
+            return unknown_count;
+
+        return firstCount + secondCount;
+    }
+
+    size_t elements_count(std::false_type /* is exact */) const noexcept
+    {
+        return unknown_count;
+    }
+
+    first_head first;
+    second_head second;
+    Compare compare;
+    bool fromFirst;
+};
+
+} // exstream namespace
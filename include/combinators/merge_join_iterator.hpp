@@ -0,0 +1,146 @@
+#pragma once
+
+#include "merge_iterator.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cassert>
+#include <memory>
+#include <utility>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+// NOTE: joins two sources ordered by the key, the second source elements with the same key are kept in a buffer
+//       to pair them with every matching element of the first source
+template <typename First,
+          typename Second,
+          typename Key,
+          typename Compare,
+          typename Allocator>
+class merge_join_iterator final
+{
+    using first_head = detail::combine::head<First>;
+    using second_head = detail::combine::head<Second>;
+
+    using first_storage = typename first_head::storage;
+    using second_storage = typename second_head::storage;
+
+    using group_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<second_storage>;
+    using group_t = std::vector<second_storage, group_allocator>;
+public:
+
+    // NOTE: the first element is paired with every matching element, so both are copied (lvalues are passed by reference)
+    using result_type = std::pair<
+        decltype(std::declval<const first_storage&>().copy()),
+        decltype(std::declval<const second_storage&>().copy())
+    >;
+    using value_type = std::pair<typename first_head::value_type, typename second_head::value_type>;
+
+    explicit merge_join_iterator(First&& first, Second&& second, const Key& key, const Allocator& alloc)
+        : first(std::move(first)),
+          second(std::move(second)),
+          group(group_allocator(alloc)),
+          position(0),
+          key(key),
+          compare()
+    {
+    }
+
+    merge_join_iterator(merge_join_iterator&&) = default;
+
+    merge_join_iterator(const merge_join_iterator&) = delete;
+    merge_join_iterator& operator= (const merge_join_iterator&) = delete;
+    merge_join_iterator& operator= (merge_join_iterator&&) = delete;
+
+    bool has_next()
+    {
+        return fetch();
+    }
+
+    result_type next()
+    {
+        const bool found = fetch();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        return result_type(first.copy(), group[position++].copy());
+    }
+
+    void skip()
+    {
+        const bool found = fetch();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        ++position;
+    }
+
+    size_t elements_count() const noexcept
+    {
+        return unknown_count;
+    }
+
+private:
+
+    // NOTE: moves the sources until the first head matches the buffered group and the group isn't exhausted
+    bool fetch()
+    {
+        while (first.has_value())
+        {
+            if (!group.empty())
+            {
+                const auto& groupKey = key(group.front().get_ref());
+                const auto& firstKey = key(first.get());
+
+                if (compare(firstKey, groupKey))
+                {
+                    first.drop();
+                    continue;
+                }
+
+                if (!compare(groupKey, firstKey))
+                {
+                    if (position != group.size()) return true;
+
+                    first.drop();
+                    position = 0;
+                    continue;
+                }
+
+                group.clear();
+                position = 0;
+            }
+
+            if (!fill_group()) return false;
+        }
+
+        return false;
+    }
+
+    bool fill_group()
+    {
+        const auto& firstKey = key(first.get());
+
+        while (second.has_value() && compare(key(second.get()), firstKey))
+            second.drop();
+
+        while (second.has_value() && !compare(firstKey, key(second.get())))
+            group.push_back(second.take_storage());
+
+        if (!group.empty()) return true;
+        if (!second.has_value()) return false;
+
+        first.drop();
+        return true;
+    }
+
+    first_head first;
+    second_head second;
+    group_t group;
+    size_t position;
+    const Key& key;
+    Compare compare;
+};
+
+} // exstream namespace
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "config.hpp"
+#include "utility.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+template <typename... Iterators>
+class zip_iterator final
+{
+    using indices = std::index_sequence_for<Iterators...>;
+public:
+
+    using value_type = std::tuple<typename Iterators::value_type...>;
+    using result_type = std::tuple<typename Iterators::result_type...>;
+
+    explicit zip_iterator(Iterators&&... iterators) noexcept(std::conjunction_v<std::is_nothrow_move_constructible<Iterators>...>)
+        : iterators(std::move(iterators)...)
+    {
+    }
+
+    zip_iterator(zip_iterator&&) = default;
+
+    zip_iterator(const zip_iterator&) = delete;
+    zip_iterator& operator= (const zip_iterator&) = delete;
+    zip_iterator& operator= (zip_iterator&&) = delete;
+
+    bool has_next()
+    {
+        return has_next(indices());
+    }
+
+    result_type next()
+    {
+        assert(has_next() && "Iterator is out of range");
+        return next(indices());
+    }
+
+    void skip()
+    {
+        assert(has_next() && "Iterator is out of range");
+        skip(indices());
+    }
+
+    // NOTE: the shortest source limits the zip, so the count is exact only if every source count is known
+    size_t elements_count() const
+    {
+        return elements_count(indices());
+    }
+
+private:
+
+    template <size_t... Indices>
+    bool has_next(std::index_sequence<Indices...>)
+    {
+        bool result = true;
+        (void)std::initializer_list<int>{ (void(result = result && std::get<Indices>(iterators).has_next()), 0)... };
+        return result;
+    }
+
+    template <size_t... Indices>
+    result_type next(std::index_sequence<Indices...>)
+    {
+        return result_type(std::get<Indices>(iterators).next()...);
+    }
+
+    template <size_t... Indices>
+    void skip(std::index_sequence<Indices...>)
+    {
+        (void)std::initializer_list<int>{ (void(std::get<Indices>(iterators).skip()), 0)... };
+    }
+
+    template <size_t... Indices>
+    size_t elements_count(std::index_sequence<Indices...>) const
+    {
+        const size_t counts[] = { std::get<Indices>(iterators).elements_count()... };
+
+        if (std::find(std::begin(counts), std::end(counts), unknown_count) != std::end(counts))
+            return unknown_count;
+
+        return *std::min_element(std::begin(counts), std::end(counts));
+    }
+
+    std::tuple<Iterators...> iterators;
+};
+
+} // exstream namespace
@@ -38,4 +38,22 @@
 #   define EXSTREAM_FORCEINLINE __attribute__((always_inline))
 #endif
 
+// NOTE: MSVC keeps __cplusplus at 199711L unless /Zc:__cplusplus is set
+#ifdef _MSVC_LANG
+#   define EXSTREAM_CPLUSPLUS _MSVC_LANG
+#else
+#   define EXSTREAM_CPLUSPLUS __cplusplus
+#endif
+
+#if EXSTREAM_CPLUSPLUS >= 201703L
+#   define EXSTREAM_CXX17
+#endif
+
+// NOTE: the coroutine integration is opt-in, it is available when the project is built with C++20
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#   if __has_include(<coroutine>)
+#       define EXSTREAM_COROUTINES
+#   endif
+#endif
+
 #define EXSTREAM_UNUSED(var) (void) var;
@@ -0,0 +1,571 @@
+#pragma once
+
+#include "config.hpp"
+
+#ifndef EXSTREAM_COROUTINES
+#   error "Coroutine integration requires C++20 coroutines, configure with -Dcoroutines=ON"
+#endif
+
+#include "stream_of.hpp"
+#include "option.hpp"
+#include "meta_info.hpp"
+#include "detail/type_traits.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cassert>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+template <typename T>
+class task;
+
+template <typename T>
+class generator;
+
+template <typename T>
+class async_generator;
+
+namespace detail {
+namespace coroutine {
+
+// NOTE: transfers the control to the awaiting coroutine, a coroutine resumed directly returns to its caller
+struct continuation_awaiter final
+{
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(const std::coroutine_handle<Promise> handle) const noexcept
+    {
+        return handle.promise().continuation;
+    }
+
+    void await_resume() const noexcept
+    {
+    }
+};
+
+// NOTE: a yielded lvalue is copied into the coroutine frame, rvalues are referenced until the generator is resumed
+template <typename T>
+struct copy_awaiter final
+{
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(const std::coroutine_handle<Promise> handle) noexcept
+    {
+        handle.promise().current = std::addressof(value);
+        return handle.promise().continuation;
+    }
+
+    void await_resume() const noexcept
+    {
+    }
+
+    T value;
+};
+
+struct task_promise_base
+{
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    continuation_awaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception() noexcept
+    {
+        error = std::current_exception();
+    }
+
+    void rethrow() const
+    {
+        if (error) std::rethrow_exception(error);
+    }
+
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr error;
+};
+
+template <typename T>
+struct task_promise final : task_promise_base
+{
+    task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& value)
+    {
+        result.emplace(std::forward<U>(value));
+    }
+
+    T take()
+    {
+        rethrow();
+        return std::move(result.get());
+    }
+
+    option<T> result;
+};
+
+template <>
+struct task_promise<void> final : task_promise_base
+{
+    task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept
+    {
+    }
+
+    void take() const
+    {
+        rethrow();
+    }
+};
+
+template <typename T>
+struct yield_promise_base
+{
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    continuation_awaiter final_suspend() noexcept
+    {
+        current = nullptr;
+        return {};
+    }
+
+    continuation_awaiter yield_value(std::remove_reference_t<T>&& value) noexcept
+    {
+        current = std::addressof(value);
+        return {};
+    }
+
+    copy_awaiter<T> yield_value(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>)
+    {
+        return copy_awaiter<T>{ value };
+    }
+
+    void return_void() const noexcept
+    {
+    }
+
+    void unhandled_exception() noexcept
+    {
+        error = std::current_exception();
+    }
+
+    T take() noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        assert(current != nullptr && "Generator has no value");
+        T value = std::move(*current);
+        current = nullptr;
+        return value;
+    }
+
+    T* current = nullptr;
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr error;
+};
+
+template <typename Promise>
+class unique_handle final
+{
+public:
+
+    explicit unique_handle(const std::coroutine_handle<Promise> handle) noexcept
+        : handle(handle)
+    {
+    }
+
+    unique_handle(unique_handle&& that) noexcept
+        : handle(std::exchange(that.handle, nullptr))
+    {
+    }
+
+    unique_handle(const unique_handle&) = delete;
+
+    unique_handle& operator= (const unique_handle&) = delete;
+    unique_handle& operator= (unique_handle&&) = delete;
+
+    ~unique_handle() noexcept
+    {
+        if (handle) handle.destroy();
+    }
+
+    std::coroutine_handle<Promise> get() const noexcept
+    {
+        return handle;
+    }
+
+    Promise& promise() const noexcept
+    {
+        return handle.promise();
+    }
+
+private:
+
+    std::coroutine_handle<Promise> handle;
+};
+
+template <typename T>
+class generator_iterator final
+{
+public:
+
+    using value_type = T;
+    using result_type = T;
+
+    explicit generator_iterator(generator<T>& source) noexcept
+        : source(std::addressof(source))
+    {
+    }
+
+    bool has_next()
+    {
+        return source->fetch();
+    }
+
+    result_type next()
+    {
+        const bool found = source->fetch();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        return source->take();
+    }
+
+    void skip()
+    {
+        next();
+    }
+
+    size_t elements_count() const noexcept
+    {
+        return unknown_count;
+    }
+
+private:
+
+    generator<T>* source;
+};
+
+}} // detail::coroutine namespace
+
+// NOTE: a lazy coroutine, it starts when it is awaited and resumes the awaiting coroutine when it finishes
+template <typename T = void>
+class [[nodiscard]] task final
+{
+public:
+
+    using promise_type = detail::coroutine::task_promise<T>;
+
+    explicit task(const std::coroutine_handle<promise_type> handle) noexcept
+        : handle(handle)
+    {
+    }
+
+    task(task&&) = default;
+
+    task(const task&) = delete;
+    task& operator= (const task&) = delete;
+    task& operator= (task&&) = delete;
+
+    auto operator co_await() noexcept
+    {
+        struct awaiter final
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(const std::coroutine_handle<> awaiting) noexcept
+            {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            T await_resume()
+            {
+                return handle.promise().take();
+            }
+
+            std::coroutine_handle<promise_type> handle;
+        };
+
+        return awaiter{ handle.get() };
+    }
+
+private:
+
+    detail::coroutine::unique_handle<promise_type> handle;
+};
+
+// NOTE: a synchronous producer, a stream of a generator resumes it for every element
+template <typename T>
+class generator final
+{
+public:
+
+    struct promise_type final : detail::coroutine::yield_promise_base<T>
+    {
+        generator get_return_object() noexcept
+        {
+            return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        // NOTE: an awaiting generator would return to the stream before it yields, use async_generator instead
+        template <typename U>
+        std::suspend_never await_transform(U&&) = delete;
+    };
+
+    generator(generator&&) = default;
+
+    generator(const generator&) = delete;
+    generator& operator= (const generator&) = delete;
+    generator& operator= (generator&&) = delete;
+
+private:
+
+    friend class detail::coroutine::generator_iterator<T>;
+
+    explicit generator(const std::coroutine_handle<promise_type> handle) noexcept
+        : handle(handle)
+    {
+    }
+
+    bool fetch()
+    {
+        auto& promise = handle.promise();
+        if (promise.current == nullptr && !handle.get().done())
+        {
+            handle.get().resume();
+            if (promise.error) std::rethrow_exception(std::exchange(promise.error, nullptr));
+        }
+
+        return promise.current != nullptr;
+    }
+
+    T take()
+    {
+        return handle.promise().take();
+    }
+
+    detail::coroutine::unique_handle<promise_type> handle;
+};
+
+// NOTE: a producer which may await between the elements, the awaiting consumer is resumed by the generator,
+//       so it continues on the thread which completed the last awaited operation
+template <typename T>
+class async_generator final
+{
+public:
+
+    struct promise_type final : detail::coroutine::yield_promise_base<T>
+    {
+        async_generator get_return_object() noexcept
+        {
+            return async_generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+
+    async_generator(async_generator&&) = default;
+
+    async_generator(const async_generator&) = delete;
+    async_generator& operator= (const async_generator&) = delete;
+    async_generator& operator= (async_generator&&) = delete;
+
+    // NOTE: the awaited option is empty at the end of the generator
+    auto next() noexcept
+    {
+        struct awaiter final
+        {
+            bool await_ready() const noexcept
+            {
+                return handle.done();
+            }
+
+            std::coroutine_handle<> await_suspend(const std::coroutine_handle<> awaiting) noexcept
+            {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            option<T> await_resume()
+            {
+                auto& promise = handle.promise();
+                if (promise.error) std::rethrow_exception(std::exchange(promise.error, nullptr));
+                if (promise.current == nullptr) return option<T>();
+
+                return option<T>(promise.take());
+            }
+
+            std::coroutine_handle<promise_type> handle;
+        };
+
+        return awaiter{ handle.get() };
+    }
+
+private:
+
+    explicit async_generator(const std::coroutine_handle<promise_type> handle) noexcept
+        : handle(handle)
+    {
+    }
+
+    detail::coroutine::unique_handle<promise_type> handle;
+};
+
+namespace detail {
+namespace coroutine {
+
+template <typename T>
+task<T> task_promise<T>::get_return_object() noexcept
+{
+    return task<T>(std::coroutine_handle<task_promise>::from_promise(*this));
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept
+{
+    return task<void>(std::coroutine_handle<task_promise>::from_promise(*this));
+}
+
+// NOTE: a coroutine started eagerly and destroyed at its end, used to block on a task
+struct detached_task final
+{
+    struct promise_type final
+    {
+        detached_task get_return_object() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_void() const noexcept
+        {
+        }
+
+        [[noreturn]]
+        void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+struct wait_state final
+{
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::exception_ptr error;
+    bool done = false;
+};
+
+// NOTE: the state is notified under the lock, so the waiting thread can't destroy it before the notification
+template <typename T, typename Result>
+detached_task run(task<T>& source, Result& result, wait_state& state)
+{
+    try
+    {
+        if constexpr (std::is_void_v<T>) co_await source;
+        else                             result.emplace(co_await source);
+    }
+    catch (...)
+    {
+        state.error = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.done = true;
+    state.condition.notify_one();
+}
+
+}} // detail::coroutine namespace
+
+// NOTE: blocks the calling thread until the task finishes, the bridge from synchronous code
+template <typename T>
+T sync_wait(task<T>&& source)
+{
+    using result_t = std::conditional_t<std::is_void_v<T>, nothing_t, T>;
+
+    option<result_t> result;
+    detail::coroutine::wait_state state;
+    detail::coroutine::run(source, result, state);
+
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.condition.wait(lock, [&] { return state.done; });
+
+    if (state.error) std::rethrow_exception(state.error);
+    if constexpr (!std::is_void_v<T>) return std::move(result.get());
+}
+
+template <typename T, typename Function>
+task<> async_foreach(async_generator<T>& source, Function function)
+{
+    for (;;)
+    {
+        auto value = co_await source.next();
+        if (value.empty()) co_return;
+
+        function(std::move(value.get()));
+    }
+}
+
+template <typename T, typename Collector>
+auto async_collect(async_generator<T>& source, Collector collector) -> task<decltype(collector.builder(type_t<T>()).build())>
+{
+    auto builder = collector.builder(type_t<T>());
+
+    for (;;)
+    {
+        auto value = co_await source.next();
+        if (value.empty()) break;
+
+        builder.append(std::move(value.get()));
+    }
+
+    co_return builder.build();
+}
+
+template <typename Allocator = std::allocator<unsigned char>, typename T>
+auto stream_of(generator<T>& source, const Allocator& alloc = Allocator())
+{
+    using meta = meta_info<false, false, Order::Unknown>;
+    return detail::make_stream<meta>(detail::coroutine::generator_iterator<T>(source), alloc);
+}
+
+template <typename Allocator = std::allocator<unsigned char>, typename T>
+auto stream_of(generator<T>&& source, const Allocator& alloc = Allocator())
+{
+    return stream_of(source, alloc);
+}
+
+} // exstream namespace
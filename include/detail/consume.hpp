@@ -0,0 +1,29 @@
+#pragma once
+
+#include "traits.hpp"
+
+namespace exstream {
+namespace detail {
+
+// NOTE: passes all the remaining elements to the function, iterators with a push mode drain themselves
+template <typename Iterator, typename Function>
+void consume(Iterator& iter, Function& function, std::true_type /* has drain */)
+{
+    iter.drain(function);
+}
+
+template <typename Iterator, typename Function>
+void consume(Iterator& iter, Function& function, std::false_type /* has drain */)
+{
+    while (iter.has_next())
+        function(iter.next());
+}
+
+template <typename Iterator, typename Function>
+void consume(Iterator& iter, Function&& function)
+{
+    consume(iter, function, has_drain_method<Iterator&, Function&>());
+}
+
+} // detail namespace
+} // exstream namespace
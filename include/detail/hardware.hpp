@@ -0,0 +1,15 @@
+#pragma once
+
+#include "config.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cstddef>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+
+constexpr size_t cache_line_size = 64;
+
+} // detail namespace
+} // exstream namespace
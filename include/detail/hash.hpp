@@ -0,0 +1,42 @@
+#pragma once
+
+#include "config.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cstdint>
+#include <functional>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+
+// NOTE: the murmur3 finalizer, std::hash of integers is usually the identity, so its bits are mixed
+//       before they are used as independent random bits by the sketches
+constexpr uint64_t mix_hash(uint64_t value) noexcept
+{
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+template <typename T>
+uint64_t hash_of(const T& value)
+{
+    return mix_hash(uint64_t(std::hash<T>()(value)));
+}
+
+// NOTE: the hasher of the containers keyed by the sketched elements
+template <typename T>
+struct mixed_hash final
+{
+    size_t operator() (const T& value) const
+    {
+        return size_t(hash_of(value));
+    }
+};
+
+} // detail namespace
+} // exstream namespace
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "option.hpp"
+#include "hardware.hpp"
+#include "scope_guard.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+
+// NOTE: a bounded lock-free queue of many producers and many consumers. Every cell has a sequence number,
+//       a producer claims the cell whose sequence equals its position and a consumer the cell whose sequence
+//       is one past its position, so the sides contend only on the positions and on the claimed cells
+template <typename T, typename Allocator>
+class mpmc_queue final
+{
+    struct cell final
+    {
+        std::atomic<size_t> sequence;
+        option<T> value;
+    };
+
+    using cell_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<cell>;
+public:
+
+    explicit mpmc_queue(const size_t capacity, const Allocator& alloc)
+        : cells(round_capacity(capacity), cell_allocator(alloc)),
+          mask(cells.size() - 1),
+          sharedPadding(),
+          enqueuePosition(0),
+          producerPadding(),
+          dequeuePosition(0),
+          consumerPadding()
+    {
+        for (size_t i = 0; i < cells.size(); ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue(mpmc_queue&&) = delete;
+
+    mpmc_queue& operator= (const mpmc_queue&) = delete;
+    mpmc_queue& operator= (mpmc_queue&&) = delete;
+
+    // NOTE: the value is constructed only when a cell is claimed, so the arguments are untouched on failure
+    template <typename... Args>
+    bool try_push(Args&&... args)
+    {
+        auto position = enqueuePosition.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto& target = cells[position & mask];
+            const auto distance = std::intptr_t(target.sequence.load(std::memory_order_acquire) - position);
+
+            if (distance < 0) return false;
+
+            if (distance > 0)
+            {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+            else if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                // NOTE: the cell is published even if the construction throws, the consumers skip empty cells
+                EXSTREAM_SCOPE_EXIT noexcept
+                {
+                    target.sequence.store(position + 1, std::memory_order_release);
+                };
+
+                target.value.emplace(std::forward<Args>(args)...);
+                return true;
+            }
+        }
+    }
+
+    bool try_pop(option<T>& result)
+    {
+        auto position = dequeuePosition.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto& source = cells[position & mask];
+            const auto distance = std::intptr_t(source.sequence.load(std::memory_order_acquire) - (position + 1));
+
+            if (distance < 0) return false;
+
+            if (distance > 0)
+            {
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+            else if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                const auto claimed = position;
+                EXSTREAM_SCOPE_EXIT noexcept
+                {
+                    source.value.reset();
+                    source.sequence.store(claimed + mask + 1, std::memory_order_release);
+                };
+
+                if (source.value.empty())
+                {
+                    position = dequeuePosition.load(std::memory_order_relaxed);
+                    continue;
+                }
+
+                result.emplace(std::move(source.value.get()));
+                return true;
+            }
+        }
+    }
+
+private:
+
+    static size_t round_capacity(const size_t capacity) noexcept
+    {
+        size_t result = 2;
+        while (result < capacity)
+            result *= 2;
+
+        return result;
+    }
+
+    std::vector<cell, cell_allocator> cells;
+    const size_t mask;
+    char sharedPadding[cache_line_size];
+
+    std::atomic<size_t> enqueuePosition;
+    char producerPadding[cache_line_size];
+
+    std::atomic<size_t> dequeuePosition;
+    char consumerPadding[cache_line_size];
+};
+
+} // detail namespace
+} // exstream namespace
@@ -41,4 +41,23 @@ struct partial_apply4 final
     using bind_4 = T<_1, _2, _3, Arg>;
 };
 
+template <template <typename, typename, typename, typename, typename> class T, typename Arg>
+struct partial_apply5 final
+{
+    template <typename _2, typename _3, typename _4, typename _5>
+    using bind_1 = T<Arg, _2, _3, _4, _5>;
+
+    template <typename _1, typename _3, typename _4, typename _5>
+    using bind_2 = T<_1, Arg, _3, _4, _5>;
+
+    template <typename _1, typename _2, typename _4, typename _5>
+    using bind_3 = T<_1, _2, Arg, _4, _5>;
+
+    template <typename _1, typename _2, typename _3, typename _5>
+    using bind_4 = T<_1, _2, _3, Arg, _5>;
+
+    template <typename _1, typename _2, typename _3, typename _4>
+    using bind_5 = T<_1, _2, _3, _4, Arg>;
+};
+
 } // exstream namespace
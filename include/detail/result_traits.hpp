@@ -1,9 +1,12 @@
 #pragma once
 
 #include "config.hpp"
+#include "niche_traits.hpp"
 
 EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <exception>
 #include <functional>
+#include <memory>
 EXSTREAM_RESTORE_ALL_WARNINGS
 
 // NOTE: depends on result of std::result_of
@@ -79,7 +82,7 @@ private:
     [[noreturn]]
     static T copy(std::false_type /* is copy constructible */) noexcept
     {
-        std:terminate(); // dummy terminate
+        std::terminate(); // dummy terminate
     }
 
     T value;
@@ -103,12 +106,12 @@ class reference_storage final
 public:
 
     explicit reference_storage(const T& ref) noexcept
-        : ref(ref)
+        : ptr(std::addressof(ref))
     {
     }
 
     explicit reference_storage(const std::reference_wrapper<T> ref) noexcept
-        : ref(ref)
+        : ptr(std::addressof(ref.get()))
     {
     }
 
@@ -120,42 +123,43 @@ public:
 
     const T& get_ref() const noexcept
     {
-        return ref.get();
+        return *ptr;
     }
 
     const T& release() const noexcept
     {
-        return ref.get();
+        return *ptr;
     }
 
     const T& copy() const noexcept
     {
-        return ref.get();
+        return *ptr;
     }
 
     bool operator== (const reference_storage& that) const noexcept(is_nothrow_comparable_v<const T>)
     {
-        return ref.get() == that.get_ref();
+        return *ptr == that.get_ref();
     }
 
     bool operator!= (const reference_storage& that) const noexcept(is_nothrow_comparable_v<const T>)
     {
-        return !(ref.get() == that.get_ref());
+        return !(*ptr == that.get_ref());
     }
 
     bool operator== (const T& that) const noexcept(is_nothrow_comparable_v<const T>)
     {
-        return ref.get() == that;
+        return *ptr == that;
     }
 
     bool operator!= (const T& that) const noexcept(is_nothrow_comparable_v<const T>)
     {
-        return !(ref.get() == that);
+        return !(*ptr == that);
     }
 
 private:
 
-    std::reference_wrapper<const T> ref;
+    // NOTE: a pointer instead of std::reference_wrapper to have a known layout for niche_traits
+    const T* ptr;
 };
 
 template <typename T>
@@ -172,6 +176,13 @@ bool operator!= (const T& value, const reference_storage<T> storage) noexcept(is
 
 } // detail namespace
 
+// NOTE: caches of transformations keep their emptiness in the storage niches
+template <typename T>
+struct niche_traits<detail::value_storage<T>> : niche_traits<T> {};
+
+template <typename T>
+struct niche_traits<detail::reference_storage<T>> : detail::pointer_niche_traits<detail::reference_storage<T>> {};
+
 template <typename T>
 struct result_traits
 {
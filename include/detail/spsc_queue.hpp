@@ -0,0 +1,120 @@
+#pragma once
+
+#include "option.hpp"
+#include "hardware.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+
+// NOTE: a bounded lock-free queue of a single producer and a single consumer. Both sides publish their positions
+//       once per batch to touch the shared cache lines rarely, a side flushes its position before waiting for
+//       the other one, so a partial batch never stalls the queue
+template <typename T, typename Allocator>
+class spsc_queue final
+{
+    using slot = option<T>;
+    using slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<slot>;
+public:
+
+    explicit spsc_queue(const size_t capacity, const size_t batch, const Allocator& alloc)
+        : slots(round_capacity(capacity), slot_allocator(alloc)),
+          mask(slots.size() - 1),
+          batch(std::max(size_t(1), std::min(batch, slots.size() / 2))),
+          head(0),
+          write(0),
+          cachedTail(0),
+          producerPadding(),
+          tail(0),
+          read(0),
+          cachedHead(0),
+          consumerPadding()
+    {
+    }
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue(spsc_queue&&) = delete;
+
+    spsc_queue& operator= (const spsc_queue&) = delete;
+    spsc_queue& operator= (spsc_queue&&) = delete;
+
+    // NOTE: producer side, the value is consumed only when the push succeeds
+    template <typename... Args>
+    bool try_push(Args&&... args)
+    {
+        if (write - cachedTail == slots.size())
+        {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (write - cachedTail == slots.size()) return false;
+        }
+
+        slots[write & mask].emplace(std::forward<Args>(args)...);
+        if (++write - head.load(std::memory_order_relaxed) >= batch)
+            flush_push();
+
+        return true;
+    }
+
+    void flush_push() noexcept
+    {
+        head.store(write, std::memory_order_release);
+    }
+
+    // NOTE: consumer side
+    T* front() noexcept
+    {
+        if (read == cachedHead)
+        {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (read == cachedHead) return nullptr;
+        }
+
+        return &slots[read & mask].get();
+    }
+
+    void pop() noexcept(std::is_nothrow_destructible_v<T>)
+    {
+        slots[read & mask].reset();
+        if (++read - tail.load(std::memory_order_relaxed) >= batch)
+            flush_pop();
+    }
+
+    void flush_pop() noexcept
+    {
+        tail.store(read, std::memory_order_release);
+    }
+
+private:
+
+    static size_t round_capacity(const size_t capacity) noexcept
+    {
+        size_t result = 2;
+        while (result < capacity)
+            result *= 2;
+
+        return result;
+    }
+
+    std::vector<slot, slot_allocator> slots;
+    const size_t mask;
+    const size_t batch;
+
+    std::atomic<size_t> head;
+    size_t write;
+    size_t cachedTail;
+    char producerPadding[cache_line_size];
+
+    std::atomic<size_t> tail;
+    size_t read;
+    size_t cachedHead;
+    char consumerPadding[cache_line_size];
+};
+
+} // detail namespace
+} // exstream namespace
@@ -5,6 +5,7 @@
 
 EXSTREAM_SUPPRESS_ALL_WARNINGS
 #include <iterator>
+#include <vector>
 EXSTREAM_RESTORE_ALL_WARNINGS
 
 namespace exstream {
@@ -20,6 +21,11 @@ EXSTREAM_DEFINE_HAS_METHOD(reserve)
 EXSTREAM_DEFINE_HAS_METHOD(append)
 EXSTREAM_DEFINE_HAS_METHOD(build)
 EXSTREAM_DEFINE_HAS_METHOD(builder)
+EXSTREAM_DEFINE_HAS_METHOD(append_range)
+EXSTREAM_DEFINE_HAS_METHOD(insert)
+EXSTREAM_DEFINE_HAS_METHOD(drain)
+EXSTREAM_DEFINE_HAS_METHOD(splice)
+EXSTREAM_DEFINE_HAS_METHOD(add)
 
 template <typename T>
 struct is_iterator
@@ -87,6 +93,44 @@ constexpr bool is_random_access_iterator_v = is_random_access_iterator<T>::value
 
 namespace detail {
 
+template <typename T>
+struct is_vector_iterator
+{
+    using value_type = typename std::iterator_traits<T>::value_type;
+    using vector_t = std::vector<value_type>;
+
+    using result = std::conjunction<
+        std::negation<std::is_same<value_type, bool>>,
+        std::disjunction<
+            std::is_same<T, typename vector_t::iterator>,
+            std::is_same<T, typename vector_t::const_iterator>
+        >
+    >;
+};
+
+template <typename T, bool IsRandomAccess = is_random_access_iterator_v<T>>
+struct is_contiguous_iterator : std::false_type {};
+
+template <typename T>
+struct is_contiguous_iterator<T, true> : is_vector_iterator<T>::result {};
+
+template <typename T>
+struct is_contiguous_iterator<T*, true> : std::true_type {};
+
+template <typename T>
+struct is_contiguous_iterator<std::move_iterator<T>, true> : is_contiguous_iterator<T> {};
+
+} // detail namespace
+
+// NOTE: there is no contiguous iterator tag before C++ 20, so only pointers and vector iterators are recognized
+template <typename T>
+using is_contiguous_iterator = detail::is_contiguous_iterator<T>;
+
+template <typename T>
+constexpr bool is_contiguous_iterator_v = is_contiguous_iterator<T>::value;
+
+namespace detail {
+
 template <bool IsIterator, typename T>
 struct is_const_iterator : std::false_type
 {
@@ -199,6 +243,12 @@ struct is_collector<T, Element, std::void_t<decltype(std::declval<T>().builder(s
 template <typename T, typename Element>
 constexpr bool is_collector_v = is_collector<T, Element>::value;
 
+template <typename T, typename Element>
+using is_aggregator = detail::has_add_method<T&, const Element&>;
+
+template <typename T, typename Element>
+constexpr bool is_aggregator_v = is_aggregator<T, Element>::value;
+
 // TODO: test
 template <typename T>
 using is_any_pair = std::disjunction<is_pair<T>, is_tuple_n<2, T>>;
@@ -35,6 +35,8 @@ EXSTREAM_RESTORE_ALL_WARNINGS
     template <typename T, typename... Args>\
     constexpr bool has_ ## methodName ## _method_v = has_ ## methodName ## _method<T, Args...>::value;
 
+// NOTE: the C++17 library traits which are missing in the C++14 mode
+#ifndef EXSTREAM_CXX17
 namespace std {
 
 #if defined(EXSTREAM_GCC) || defined(EXSTREAM_CLANG)
@@ -72,6 +74,7 @@ template <typename T>
 constexpr bool is_nothrow_swappable_v = is_nothrow_swappable<T>::value;
 
 } // std namespace
+#endif
 
 namespace exstream {
 
@@ -81,6 +84,21 @@ using remove_cvr = std::remove_cv<std::remove_reference_t<T>>;
 template <typename T>
 using remove_cvr_t = typename remove_cvr<T>::type;
 
+// NOTE: std::result_of is deprecated in C++17 and removed in C++20
+#ifdef EXSTREAM_CXX17
+template <typename Signature>
+struct result_of;
+
+template <typename Function, typename... Args>
+struct result_of<Function(Args...)> : std::invoke_result<Function, Args...> {};
+#else
+template <typename Signature>
+using result_of = std::result_of<Signature>;
+#endif
+
+template <typename Signature>
+using result_of_t = typename result_of<Signature>::type;
+
 template <typename T, typename U, typename AlwaysVoid = std::void_t<>>
 struct is_comparable_to : std::false_type {};
 
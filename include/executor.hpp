@@ -0,0 +1,117 @@
+#pragma once
+
+#include "config.hpp"
+#include "detail/scope_guard.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+// NOTE: an executor is any object callable with a task (a copyable function without arguments),
+//       it has to run the task asynchronously, stages started on the caller thread would never finish
+struct thread_executor final
+{
+    template <typename Task>
+    void operator() (Task&& task) const
+    {
+        std::thread(std::forward<Task>(task)).detach();
+    }
+};
+
+// NOTE: a fixed set of threads running the tasks in the submission order, the destructor runs the pending tasks
+//       and joins the threads, so the pool should outlive the streams using it
+class thread_pool final
+{
+public:
+
+    explicit thread_pool(const size_t threadsCount = std::max(1u, std::thread::hardware_concurrency()))
+        : mutex(),
+          condition(),
+          tasks(),
+          threads(),
+          stopped(false)
+    {
+        EXSTREAM_SCOPE_FAIL
+        {
+            stop();
+        };
+
+        threads.reserve(threadsCount);
+        for (size_t i = 0; i < threadsCount; ++i)
+            threads.emplace_back([this] { work(); });
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool(thread_pool&&) = delete;
+
+    thread_pool& operator= (const thread_pool&) = delete;
+    thread_pool& operator= (thread_pool&&) = delete;
+
+    ~thread_pool() noexcept
+    {
+        stop();
+    }
+
+    template <typename Task>
+    void operator() (Task&& task) const
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace_back(std::forward<Task>(task));
+        }
+        condition.notify_one();
+    }
+
+    size_t size() const noexcept
+    {
+        return threads.size();
+    }
+
+private:
+
+    void work()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this] { return stopped || !tasks.empty(); });
+                if (tasks.empty()) return;
+
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    void stop() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        condition.notify_all();
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    mutable std::mutex mutex;
+    mutable std::condition_variable condition;
+    mutable std::deque<std::function<void()>> tasks;
+    std::vector<std::thread> threads;
+    bool stopped;
+};
+
+} // exstream namespace
@@ -0,0 +1,659 @@
+#pragma once
+
+#include "config.hpp"
+#include "utility.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <chrono>
+#include <iosfwd>
+#include <memory>
+#include <type_traits>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+// NOTE: define EXSTREAM_INSTRUMENTATION to record statistics of every transformation stage,
+//       it changes the pipeline types, so it has to be defined consistently for the whole program
+
+namespace exstream {
+
+template <typename Iterator, typename Function, typename Meta>
+class map_iterator;
+
+template <typename Iterator, typename Function, typename Meta>
+class filter_iterator;
+
+template <typename Iterator, typename Function, typename Meta, typename Allocator>
+class flat_map_iterator;
+
+template <typename Iterator, typename Function, typename Meta, typename Allocator, typename T>
+class flat_map_into_iterator;
+
+template <typename Iterator, typename Meta, typename Allocator>
+class distinct_iterator;
+
+template <typename Iterator, typename Function, typename Meta>
+class filter_map_iterator;
+
+template <typename Iterator, typename Meta>
+class flatten_iterator;
+
+template <typename Iterator, typename Meta, typename T>
+class alternative_iterator;
+
+template <typename Iterator, typename Meta>
+class enumerate_iterator;
+
+template <typename Iterator, typename Parameters, typename Meta, typename Allocator>
+class window_iterator;
+
+template <typename Iterator, typename Parameters, typename Meta, typename Allocator>
+class async_iterator;
+
+template <typename Iterator, typename Parameters, typename Meta, typename Allocator>
+class par_map_iterator;
+
+template <typename Iterator, typename Parameters, typename Meta>
+class scan_iterator;
+
+template <typename Iterator, typename Parameters, typename Meta, typename Allocator>
+class bloom_distinct_iterator;
+
+struct stage_stats final
+{
+    const char* name;
+    size_t elements_in;
+    size_t elements_out;
+    std::chrono::nanoseconds time; // without the time spent in the upstream stages
+    size_t allocations;
+    size_t allocated_bytes;
+
+    double pass_ratio() const noexcept
+    {
+        return (elements_in == 0) ? 1.0 : double(elements_out) / double(elements_in);
+    }
+};
+
+class pipeline_stats final
+{
+public:
+
+    pipeline_stats() = default;
+
+    explicit pipeline_stats(std::vector<stage_stats>&& stages) noexcept
+        : stageStats(std::move(stages))
+    {
+    }
+
+    pipeline_stats(pipeline_stats&&) = default;
+    pipeline_stats& operator= (pipeline_stats&&) = default;
+
+    pipeline_stats(const pipeline_stats&) = default;
+    pipeline_stats& operator= (const pipeline_stats&) = default;
+
+    // NOTE: ordered from the source to the terminator
+    const std::vector<stage_stats>& stages() const noexcept
+    {
+        return stageStats;
+    }
+
+    bool empty() const noexcept
+    {
+        return stageStats.empty();
+    }
+
+private:
+
+    std::vector<stage_stats> stageStats;
+};
+
+template <typename CharT, typename Traits>
+std::basic_ostream<CharT, Traits>& operator<< (std::basic_ostream<CharT, Traits>& stream, const pipeline_stats& stats)
+{
+    for (const auto& stage : stats.stages())
+    {
+        stream << stage.name
+               << ": in " << stage.elements_in
+               << ", out " << stage.elements_out
+               << " (" << stage.pass_ratio() * 100.0 << "%)"
+               << ", " << stage.time.count() << " ns"
+               << ", " << stage.allocations << " allocations"
+               << " (" << stage.allocated_bytes << " bytes)\n";
+    }
+
+    return stream;
+}
+
+namespace detail {
+namespace instrumentation {
+
+template <typename Iterator>
+struct stage_name
+{
+    static constexpr const char* value = "stage";
+};
+
+template <typename Iterator, typename Function, typename Meta>
+struct stage_name<map_iterator<Iterator, Function, Meta>>
+{
+    static constexpr const char* value = "map";
+};
+
+template <typename Iterator, typename Function, typename Meta>
+struct stage_name<filter_iterator<Iterator, Function, Meta>>
+{
+    static constexpr const char* value = "filter";
+};
+
+template <typename Iterator, typename Function, typename Meta, typename Allocator>
+struct stage_name<flat_map_iterator<Iterator, Function, Meta, Allocator>>
+{
+    static constexpr const char* value = "flat_map";
+};
+
+template <typename Iterator, typename Function, typename Meta, typename Allocator, typename T>
+struct stage_name<flat_map_into_iterator<Iterator, Function, Meta, Allocator, T>>
+{
+    static constexpr const char* value = "flat_map_into";
+};
+
+template <typename Iterator, typename Meta, typename Allocator>
+struct stage_name<distinct_iterator<Iterator, Meta, Allocator>>
+{
+    static constexpr const char* value = "distinct";
+};
+
+template <typename Iterator, typename Function, typename Meta>
+struct stage_name<filter_map_iterator<Iterator, Function, Meta>>
+{
+    static constexpr const char* value = "filter_map";
+};
+
+template <typename Iterator, typename Meta>
+struct stage_name<flatten_iterator<Iterator, Meta>>
+{
+    static constexpr const char* value = "flatten";
+};
+
+template <typename Iterator, typename Meta, typename T>
+struct stage_name<alternative_iterator<Iterator, Meta, T>>
+{
+    static constexpr const char* value = "collect_variants";
+};
+
+template <typename Iterator, typename Meta>
+struct stage_name<enumerate_iterator<Iterator, Meta>>
+{
+    static constexpr const char* value = "enumerate";
+};
+
+template <typename Iterator, typename Parameters, typename Meta, typename Allocator>
+struct stage_name<window_iterator<Iterator, Parameters, Meta, Allocator>>
+{
+    static constexpr const char* value = "window";
+};
+
+template <typename Iterator, typename Parameters, typename Meta, typename Allocator>
+struct stage_name<async_iterator<Iterator, Parameters, Meta, Allocator>>
+{
+    static constexpr const char* value = "async";
+};
+
+template <typename Iterator, typename Parameters, typename Meta, typename Allocator>
+struct stage_name<par_map_iterator<Iterator, Parameters, Meta, Allocator>>
+{
+    static constexpr const char* value = "par_map";
+};
+
+template <typename Iterator, typename Parameters, typename Meta>
+struct stage_name<scan_iterator<Iterator, Parameters, Meta>>
+{
+    static constexpr const char* value = "scan";
+};
+
+template <typename Iterator, typename Parameters, typename Meta, typename Allocator>
+struct stage_name<bloom_distinct_iterator<Iterator, Parameters, Meta, Allocator>>
+{
+    static constexpr const char* value = "bloom_distinct";
+};
+
+using clock = std::chrono::steady_clock;
+
+struct stage_record final
+{
+    stage_stats stats;
+    std::chrono::nanoseconds nested;
+};
+
+class pipeline_recorder final
+{
+public:
+
+    pipeline_recorder() = default;
+
+    pipeline_recorder(const pipeline_recorder&) = delete;
+    pipeline_recorder& operator= (const pipeline_recorder&) = delete;
+
+    size_t add_stage()
+    {
+        stages.emplace_back();
+        return stages.size() - 1;
+    }
+
+    void publish(const size_t index, const stage_stats& stats) noexcept
+    {
+        stages[index] = stats;
+    }
+
+    std::vector<stage_stats> release() noexcept
+    {
+        return std::move(stages);
+    }
+
+private:
+
+    std::vector<stage_stats> stages;
+};
+
+inline stage_record*& current_stage() noexcept
+{
+    static thread_local stage_record* stage = nullptr;
+    return stage;
+}
+
+inline pipeline_recorder*& current_recorder() noexcept
+{
+    static thread_local pipeline_recorder* recorder = nullptr;
+    return recorder;
+}
+
+inline pipeline_stats& last_stats() noexcept
+{
+    static thread_local pipeline_stats stats;
+    return stats;
+}
+
+inline void record_allocation(const size_t bytes) noexcept
+{
+    if (const auto stage = current_stage())
+    {
+        ++stage->stats.allocations;
+        stage->stats.allocated_bytes += bytes;
+    }
+}
+
+class stage_scope final
+{
+public:
+
+    explicit stage_scope(stage_record& record) noexcept
+        : record(record),
+          previous(current_stage()),
+          start(clock::now())
+    {
+        current_stage() = &record;
+    }
+
+    stage_scope(const stage_scope&) = delete;
+    stage_scope& operator= (const stage_scope&) = delete;
+
+    ~stage_scope() noexcept
+    {
+        record.stats.time += std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+        current_stage() = previous;
+    }
+
+private:
+
+    stage_record& record;
+    stage_record* const previous;
+    const clock::time_point start;
+};
+
+// NOTE: time spent under this scope isn't accounted for the current stage (calls of upstream stages or of the terminator)
+class excluded_scope final
+{
+public:
+
+    excluded_scope() noexcept
+        : stage(current_stage()),
+          start(clock::now())
+    {
+        current_stage() = nullptr;
+    }
+
+    excluded_scope(const excluded_scope&) = delete;
+    excluded_scope& operator= (const excluded_scope&) = delete;
+
+    ~excluded_scope() noexcept
+    {
+        current_stage() = stage;
+
+        if (stage != nullptr)
+            stage->nested += std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+    }
+
+    stage_record* get_stage() const noexcept
+    {
+        return stage;
+    }
+
+private:
+
+    stage_record* const stage;
+    const clock::time_point start;
+};
+
+template <typename Iterator>
+class upstream_probe final
+{
+public:
+
+    using value_type = typename Iterator::value_type;
+    using result_type = typename Iterator::result_type;
+
+    upstream_probe(const Iterator& iterator) noexcept(std::is_nothrow_copy_constructible_v<Iterator>)
+        : iterator(iterator)
+    {
+    }
+
+    upstream_probe(Iterator&& iterator) noexcept(std::is_nothrow_move_constructible_v<Iterator>)
+        : iterator(std::move(iterator))
+    {
+    }
+
+    upstream_probe(upstream_probe&&) = default;
+
+    upstream_probe(const upstream_probe&) = delete;
+    upstream_probe& operator= (const upstream_probe&) = delete;
+
+    bool has_next()
+    {
+        excluded_scope scope;
+        return iterator.has_next();
+    }
+
+    result_type next()
+    {
+        excluded_scope scope;
+        count_element(scope);
+        return iterator.next();
+    }
+
+    void skip()
+    {
+        excluded_scope scope;
+        count_element(scope);
+        iterator.skip();
+    }
+
+    size_t elements_count() const noexcept(noexcept(std::declval<const Iterator&>().elements_count()))
+    {
+        return iterator.elements_count();
+    }
+
+private:
+
+    static void count_element(const excluded_scope& scope) noexcept
+    {
+        if (const auto stage = scope.get_stage())
+            ++stage->stats.elements_in;
+    }
+
+    Iterator iterator;
+};
+
+template <typename Iterator>
+class instrumented_iterator final
+{
+public:
+
+    using value_type = typename Iterator::value_type;
+    using result_type = typename Iterator::result_type;
+    using meta = typename Iterator::meta;
+
+    template <typename Upstream, typename Function, typename Allocator>
+    instrumented_iterator(Upstream&& upstream, const Function& function, const Allocator& alloc)
+        : record(make_record()),
+          recorder(current_recorder()),
+          index(register_stage(recorder)),
+          iterator(make_iterator(record, std::forward<Upstream>(upstream), function, alloc))
+    {
+    }
+
+    template <typename Upstream, typename Allocator>
+    instrumented_iterator(Upstream&& upstream, const Allocator& alloc)
+        : record(make_record()),
+          recorder(current_recorder()),
+          index(register_stage(recorder)),
+          iterator(make_iterator(record, std::forward<Upstream>(upstream), alloc))
+    {
+    }
+
+    instrumented_iterator(instrumented_iterator&& that)
+        : record(that.record),
+          recorder(that.recorder),
+          index(that.index),
+          iterator(std::move(that.iterator))
+    {
+        that.recorder = nullptr;
+    }
+
+    instrumented_iterator(const instrumented_iterator&) = delete;
+    instrumented_iterator& operator= (const instrumented_iterator&) = delete;
+
+    ~instrumented_iterator() noexcept
+    {
+        if (recorder == nullptr) return;
+
+        auto stats = record.stats;
+        stats.time -= record.nested;
+        recorder->publish(index, stats);
+    }
+
+    bool has_next()
+    {
+        stage_scope scope(record);
+        return iterator.has_next();
+    }
+
+    result_type next()
+    {
+        stage_scope scope(record);
+        ++record.stats.elements_out;
+        return iterator.next();
+    }
+
+    void skip()
+    {
+        stage_scope scope(record);
+        ++record.stats.elements_out;
+        iterator.skip();
+    }
+
+    size_t elements_count() const noexcept(noexcept(std::declval<const Iterator&>().elements_count()))
+    {
+        return iterator.elements_count();
+    }
+
+    template <typename Sink, typename InnerIterator = Iterator>
+    auto drain(Sink&& sink) -> decltype(std::declval<InnerIterator&>().drain(sink))
+    {
+        stage_scope scope(record);
+        auto& elementsOut = record.stats.elements_out;
+
+        return iterator.drain([&](auto&& value)
+        {
+            ++elementsOut;
+            excluded_scope downstream;
+            sink(std::forward<decltype(value)>(value));
+        });
+    }
+
+private:
+
+    static stage_record make_record() noexcept
+    {
+        return stage_record{ stage_stats{ stage_name<Iterator>::value, 0, 0, std::chrono::nanoseconds(0), 0, 0 }, std::chrono::nanoseconds(0) };
+    }
+
+    static size_t register_stage(pipeline_recorder* recorder)
+    {
+        return (recorder != nullptr) ? recorder->add_stage() : 0;
+    }
+
+    // NOTE: allocations made by a stage constructor are accounted for the stage
+    template <typename... Args>
+    static Iterator make_iterator(stage_record& record, Args&&... args)
+    {
+        stage_scope scope(record);
+        return Iterator(std::forward<Args>(args)...);
+    }
+
+    stage_record record;
+    pipeline_recorder* recorder;
+    size_t index;
+    Iterator iterator;
+};
+
+template <typename Allocator>
+class counting_allocator
+{
+    using traits = std::allocator_traits<Allocator>;
+public:
+
+    using value_type = typename traits::value_type;
+    using pointer = typename traits::pointer;
+    using size_type = typename traits::size_type;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = counting_allocator<typename traits::template rebind_alloc<U>>;
+    };
+
+    counting_allocator(const Allocator& alloc) noexcept
+        : alloc(alloc)
+    {
+    }
+
+    template <typename U>
+    counting_allocator(const counting_allocator<U>& that) noexcept
+        : alloc(that.get_base())
+    {
+    }
+
+    pointer allocate(const size_type count)
+    {
+        record_allocation(count * sizeof(value_type));
+        return traits::allocate(alloc, count);
+    }
+
+    void deallocate(const pointer ptr, const size_type count) noexcept
+    {
+        traits::deallocate(alloc, ptr, count);
+    }
+
+    const Allocator& get_base() const noexcept
+    {
+        return alloc;
+    }
+
+    template <typename U>
+    bool operator== (const counting_allocator<U>& that) const noexcept
+    {
+        return alloc == that.get_base();
+    }
+
+    template <typename U>
+    bool operator!= (const counting_allocator<U>& that) const noexcept
+    {
+        return !(alloc == that.get_base());
+    }
+
+private:
+
+    Allocator alloc;
+};
+
+template <typename Iterator>
+struct is_instrumented : std::false_type {};
+
+template <typename Iterator>
+struct is_instrumented<instrumented_iterator<Iterator>> : std::true_type {};
+
+class active_pipeline_scope final
+{
+public:
+
+    active_pipeline_scope() noexcept
+        : recorder(),
+          previousRecorder(current_recorder()),
+          previousStage(current_stage())
+    {
+        current_recorder() = &recorder;
+        current_stage() = nullptr;
+    }
+
+    active_pipeline_scope(const active_pipeline_scope&) = delete;
+    active_pipeline_scope& operator= (const active_pipeline_scope&) = delete;
+
+    ~active_pipeline_scope() noexcept
+    {
+        last_stats() = pipeline_stats(recorder.release());
+        current_recorder() = previousRecorder;
+        current_stage() = previousStage;
+    }
+
+private:
+
+    pipeline_recorder recorder;
+    pipeline_recorder* const previousRecorder;
+    stage_record* const previousStage;
+};
+
+class inactive_pipeline_scope final
+{
+public:
+
+    inactive_pipeline_scope() noexcept
+    {
+    }
+};
+
+// NOTE: declared by every terminator before the iterator, so the stages publish their statistics first
+template <typename Iterator>
+using pipeline_scope = std::conditional_t<is_instrumented<Iterator>::value, active_pipeline_scope, inactive_pipeline_scope>;
+
+#ifdef EXSTREAM_INSTRUMENTATION
+
+template <typename Iterator>
+using stage_t = instrumented_iterator<Iterator>;
+
+template <typename Iterator>
+using upstream_t = upstream_probe<Iterator>;
+
+template <typename Allocator>
+using allocator_t = counting_allocator<Allocator>;
+
+#else
+
+template <typename Iterator>
+using stage_t = Iterator;
+
+template <typename Iterator>
+using upstream_t = Iterator;
+
+template <typename Allocator>
+using allocator_t = Allocator;
+
+#endif
+
+}} // detail::instrumentation namespace
+
+// NOTE: statistics of the last pipeline finished by a terminator on the current thread
+inline const pipeline_stats& last_pipeline_stats() noexcept
+{
+    return detail::instrumentation::last_stats();
+}
+
+} // exstream namespace
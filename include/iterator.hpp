@@ -1,9 +1,11 @@
 #pragma once
 
-#include "detail/type_traits.hpp"
+#include "detail/traits.hpp"
 
 EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 EXSTREAM_RESTORE_ALL_WARNINGS
 
 namespace exstream {
@@ -69,14 +71,92 @@ public:
             })(nothing);
     }
 
+    template <typename Function>
+    decltype(auto) take_range(Function&& function)
+    {
+        static_assert(std::is_same_v<BeginIterator, EndIterator>, "Range requires the same begin and end iterator types");
+
+        const auto first = beginIterator;
+        beginIterator = endIterator;
+        return function(first, endIterator);
+    }
+
 private:
 
     BeginIterator beginIterator;
     EndIterator endIterator;
 };
 
+template <typename T>
+struct is_bulk_iterator : std::false_type {};
+
+template <typename BeginIterator, typename EndIterator>
+struct is_bulk_iterator<iterator<BeginIterator, EndIterator>> : std::conjunction<
+    std::is_same<BeginIterator, EndIterator>,
+    is_forward_iterator<BeginIterator>
+>
+{
+};
+
+template <typename T>
+constexpr bool is_bulk_iterator_v = is_bulk_iterator<T>::value;
+
 namespace detail {
 
+template <typename T>
+T* unwrap_contiguous(T* pointer) noexcept
+{
+    return pointer;
+}
+
+template <typename Iterator>
+auto unwrap_contiguous(const Iterator& iterator) noexcept
+{
+    return std::addressof(*iterator);
+}
+
+template <typename Iterator>
+auto unwrap_contiguous(const std::move_iterator<Iterator>& iterator) noexcept
+{
+    return unwrap_contiguous(iterator.base());
+}
+
+template <typename InputIter, typename OutputIter>
+using is_memcpy_copyable = std::conjunction<
+    is_contiguous_iterator<InputIter>,
+    is_contiguous_iterator<OutputIter>,
+    std::is_trivially_copyable<typename std::iterator_traits<InputIter>::value_type>,
+    std::is_same<typename std::iterator_traits<InputIter>::value_type, typename std::iterator_traits<OutputIter>::value_type>
+>;
+
+template <typename InputIter, typename OutputIter>
+OutputIter bulk_copy(InputIter first, InputIter last, OutputIter outIter, std::true_type /* is memcpy copyable */) noexcept
+{
+    using value_type = typename std::iterator_traits<InputIter>::value_type;
+
+    const auto count = std::distance(first, last);
+    if (count == 0) return outIter;
+
+    const auto* from = unwrap_contiguous(first);
+    auto* to = unwrap_contiguous(outIter);
+    assert(((to + count <= from) || (from + count <= to)) && "Source and destination ranges overlap");
+
+    std::memcpy(to, from, static_cast<size_t>(count) * sizeof(value_type));
+    return outIter + count;
+}
+
+template <typename InputIter, typename OutputIter>
+OutputIter bulk_copy(InputIter first, InputIter last, OutputIter outIter, std::false_type /* is memcpy copyable */)
+{
+    return std::copy(first, last, outIter);
+}
+
+template <typename InputIter, typename OutputIter>
+OutputIter bulk_copy(InputIter first, InputIter last, OutputIter outIter)
+{
+    return bulk_copy(first, last, outIter, is_memcpy_copyable<InputIter, OutputIter>());
+}
+
 template <typename BeginIterator, typename EndIterator>
 using iterator_type = iterator<std::decay_t<BeginIterator>, std::decay_t<EndIterator>>;
 
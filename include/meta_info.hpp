@@ -14,4 +14,8 @@ struct meta_info final
     static constexpr Order order      = AnOrder;
 };
 
+// NOTE: marks the inputs whose order can't be inferred, but is guaranteed by the caller
+struct assume_sorted_t final {};
+constexpr auto assume_sorted = assume_sorted_t();
+
 } // exstream namespace
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "config.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cstdint>
+#include <cstring>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+constexpr size_t niche_npos = size_t(-1);
+
+// NOTE: a niche is a bit pattern which is never produced by a valid object of the type, so wrappers like variant
+//       can keep their own state in it instead of a separate field.
+//       Specializations provide:
+//           static constexpr size_t count - number of available niches
+//           static void store(void* ptr, size_t niche) noexcept - writes niche [0, count) to the object storage
+//           static size_t load(const void* ptr) noexcept - reads the stored niche or niche_npos if the storage holds a valid object
+template <typename T>
+struct niche_traits
+{
+    static constexpr size_t count = 0;
+};
+
+namespace detail {
+
+// NOTE: pointers which are never null keep niches in the first memory page addresses, which are never mapped.
+//       Pointer wrappers should keep the pointer at the beginning of the object.
+template <typename Pointer>
+struct pointer_niche_traits
+{
+    static constexpr size_t count = 256;
+
+    static void store(void* ptr, const size_t niche) noexcept
+    {
+        const auto address = uintptr_t(niche);
+        std::memcpy(ptr, &address, sizeof(address));
+    }
+
+    static size_t load(const void* ptr) noexcept
+    {
+        uintptr_t address;
+        std::memcpy(&address, ptr, sizeof(address));
+        return (address < count) ? size_t(address) : niche_npos;
+    }
+
+    static_assert(sizeof(Pointer) >= sizeof(uintptr_t), "Pointer wrapper should have a pointer layout");
+};
+
+} // detail namespace
+
+// NOTE: only 0 and 1 are valid bool representations
+template <>
+struct niche_traits<bool>
+{
+    static constexpr size_t count = 254;
+
+    static void store(void* ptr, const size_t niche) noexcept
+    {
+        const auto representation = uint8_t(niche + 2);
+        std::memcpy(ptr, &representation, sizeof(representation));
+    }
+
+    static size_t load(const void* ptr) noexcept
+    {
+        uint8_t representation;
+        std::memcpy(&representation, ptr, sizeof(representation));
+        return (representation > 1) ? size_t(representation - 2) : niche_npos;
+    }
+
+    static_assert(sizeof(bool) == sizeof(uint8_t), "Unsupported bool representation");
+};
+} // exstream namespace
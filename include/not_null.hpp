@@ -1,6 +1,7 @@
 #pragma once
 
 #include "config.hpp"
+#include "niche_traits.hpp"
 
 EXSTREAM_SUPPRESS_ALL_WARNINGS
 #include <cassert>
@@ -793,6 +794,10 @@ bool operator!= (nullptr_t, const not_null<std::shared_ptr<T>>&) noexcept
 
 #pragma endregion
 
+// NOTE: only a raw pointer has a niche, a moved-from smart pointer is null and would be taken for the niche
+template <typename T>
+struct niche_traits<not_null<T*>> : detail::pointer_niche_traits<not_null<T*>> {};
+
 } // exstream namespace
 
 namespace std {
@@ -823,7 +828,7 @@ struct hash<exstream::not_null<T*>>
 {
     size_t operator() (const exstream::not_null<T*>& pointer) const noexcept
     {
-        return std::hash<T*>()(pointer);
+        return std::hash<T*>()(pointer.get());
     }
 };
 
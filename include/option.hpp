@@ -3,6 +3,7 @@
 #include "utility.hpp"
 #include "detail/container_traits.hpp"
 #include "detail/type_traits.hpp"
+#include "niche_traits.hpp"
 #include "not_null.hpp"
 
 EXSTREAM_SUPPRESS_ALL_WARNINGS
@@ -130,91 +131,138 @@ using option_iterator = basic_option_iterator<T, false>;
 template <typename T>
 using const_option_iterator = basic_option_iterator<T, true>;
 
+// NOTE: option keeps its emptiness in a sentinel value of T when the type provides one, otherwise a separate flag is used.
+//       Specializations may provide their own sentinel:
+//           static constexpr bool has_sentinel
+//           static void set_empty(void* ptr) noexcept - writes the sentinel to the option storage
+//           static bool is_empty(const void* ptr) noexcept - checks whether the option storage holds the sentinel
 template <typename T>
-class option final
+struct option_traits
+{
+    static constexpr bool has_sentinel = (niche_traits<T>::count != 0);
+
+    static void set_empty(void* ptr) noexcept
+    {
+        niche_traits<T>::store(ptr, 0);
+    }
+
+    static bool is_empty(const void* ptr) noexcept
+    {
+        return niche_traits<T>::load(ptr) == 0;
+    }
+};
+
+namespace detail {
+
+template <typename T, bool HasSentinel = option_traits<T>::has_sentinel>
+class option_storage final
 {
-    static_assert(!std::is_const_v<T>, "Optional type shouldn't be const. Use 'const option<T>' declaration instead.");
-    static_assert(!std::is_volatile_v<T>, "Optional type shouldn't be volatile. Use 'volatile option<T>' declaration instead.");
-    static_assert(!std::is_rvalue_reference_v<T>, "Optional type shouldn't be a rvalue reference.");
-    static_assert(!std::is_void_v<T>, "Option can't hold a value of 'void' type.");
-    static_assert(!std::is_array_v<T>, "Option can't hold a value of array type.");
-    static_assert(std::is_destructible_v<T>, "Optional type should be destructible");
 public:
 
-    using value_type = T;
-    using iterator = option_iterator<T>;
-    using const_iterator = const_option_iterator<T>;
-    using reverse_iterator = iterator;
-    using const_reverse_iterator = const_iterator;
-    
-    option() noexcept
+    option_storage() noexcept
         : storage(),
           emptyFlag(true)
     {
     }
-    
-    explicit option(const none_t&) noexcept
-        : option()
+
+    void* pointer() noexcept
     {
+        return reinterpret_cast<void*>(std::addressof(storage));
     }
-    
-    explicit option(const T& that) noexcept(std::is_nothrow_copy_constructible_v<T>)
-        : storage(),
-          emptyFlag(false)
+
+    const void* pointer() const noexcept
     {
-        constexpr_if<std::is_copy_constructible_v<T>>()
-            .then([&](auto) noexcept(std::is_nothrow_copy_constructible_v<T>)
-            {
-                construct(that);
-            })
-            .else_([](auto) noexcept
-            {
-                static_assert(false, "Optional type should be copy constructible");
-            })(nothing);
+        return reinterpret_cast<const void*>(std::addressof(storage));
     }
-    
-    explicit option(T&& that) noexcept(std::is_nothrow_move_constructible_v<T>)
-        : storage(),
-          emptyFlag(false)
+
+    bool empty() const noexcept
     {
-        constexpr_if<std::is_move_constructible_v<T>>()
-            .then([&](auto) noexcept(std::is_nothrow_move_constructible_v<T>)
-            {
-                construct(std::move(that));
-            })
-            .else_([](auto) noexcept
-            {
-                static_assert(false, "Optional type should be move constructible");
-            })(nothing);
+        return emptyFlag;
     }
-    
-    option(const option& that) noexcept(std::is_nothrow_copy_constructible_v<T>)
-        : storage(),
-          emptyFlag(that.emptyFlag)
+
+    void set_empty(const bool empty) noexcept
+    {
+        emptyFlag = empty;
+    }
+
+private:
+
+    std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+    bool emptyFlag;
+};
+
+template <typename T>
+class option_storage<T, true> final
+{
+public:
+
+    option_storage() noexcept
+        : storage()
+    {
+        option_traits<T>::set_empty(pointer());
+    }
+
+    void* pointer() noexcept
+    {
+        return reinterpret_cast<void*>(std::addressof(storage));
+    }
+
+    const void* pointer() const noexcept
+    {
+        return reinterpret_cast<const void*>(std::addressof(storage));
+    }
+
+    bool empty() const noexcept
+    {
+        return option_traits<T>::is_empty(pointer());
+    }
+
+    // NOTE: construction of the value overwrites the sentinel, so only the transition to the empty state writes it
+    void set_empty(const bool empty) noexcept
+    {
+        if (empty) option_traits<T>::set_empty(pointer());
+    }
+
+private:
+
+    std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+};
+
+// NOTE: defines the special members of option, which stay trivial when T is trivially copyable
+template <typename T, bool IsTriviallyCopyable = std::is_trivially_copyable_v<T>>
+class option_value final
+{
+public:
+
+    option_value() noexcept
+        : storage()
+    {
+    }
+
+    option_value(const option_value& that) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        : storage()
     {
         constexpr_if<std::is_copy_constructible_v<T>>()
             .then([&](auto) noexcept(std::is_nothrow_copy_constructible_v<T>)
             {
-                if (that.non_empty()) construct(that.value());
+                if (!that.empty()) initialize(that.get());
             })
             .else_([](auto) noexcept
             {
                 static_assert(false, "Optional type should be copy constructible");
             })(nothing);
     }
-    
-    option(option&& that) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
-        : storage(),
-          emptyFlag(that.emptyFlag)
+
+    option_value(option_value&& that) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+        : storage()
     {
         constexpr_if<std::is_move_constructible_v<T>>()
             .then([&](auto) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
             {
-                if (that.non_empty())
+                if (!that.empty())
                 {
-                    construct(std::move(that.value()));
-                    that.destroy();
-                    that.emptyFlag = true;
+                    initialize(std::move(that.get()));
+                    that.reset();
                 }
             })
             .else_([](auto) noexcept
@@ -222,37 +270,15 @@ public:
                 static_assert(false, "Optional type should be move constructible");
             })(nothing);
     }
-    
-    template <typename... Args>
-    explicit option(in_place_t, Args&&... arguments) noexcept(std::is_nothrow_constructible_v<T, Args...>)
-        : storage(),
-          emptyFlag(false)
-    {
-        constexpr_if<std::is_constructible_v<T, Args...>>()
-            .then([this](auto&&... args) noexcept(std::is_nothrow_constructible_v<T, decltype(args)...>)
-            {
-                construct(std::forward<decltype(args)>(args)...);
-            })
-            .else_([](auto...) noexcept
-            {
-                static_assert(false, "Optional type should be constructible from 'Ts&&...'");
-            })(std::forward<Args>(arguments)...);
-    }
-    
-    ~option() noexcept(std::is_nothrow_destructible_v<T>)
+
+    ~option_value() noexcept(std::is_nothrow_destructible_v<T>)
     {
         destroy();
     }
-    
-    option& operator= (const none_t&) noexcept(std::is_nothrow_destructible_v<T>)
-    {
-        reset();
-        return *this;
-    }
 
-    option& operator= (const option& that) noexcept(std::is_nothrow_copy_assignable_v<T>    &&
-                                                    std::is_nothrow_copy_constructible_v<T> &&
-                                                    std::is_nothrow_destructible_v<T>)
+    option_value& operator= (const option_value& that) noexcept(std::is_nothrow_copy_assignable_v<T>    &&
+                                                                std::is_nothrow_copy_constructible_v<T> &&
+                                                                std::is_nothrow_destructible_v<T>)
     {
         constexpr_if<std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>>()
             .then([&](auto) noexcept(std::is_nothrow_copy_assignable_v<T>    &&
@@ -261,9 +287,9 @@ public:
             {
                 if (!(empty() && that.empty()))
                 {
-                    if (non_empty() && that.non_empty())   assign(that.value());
-                    else if (empty() && that.non_empty())  initialize(that.value());
-                    else                                   reset();
+                    if (!empty() && !that.empty())   get() = that.get();
+                    else if (empty())                initialize(that.get());
+                    else                             reset();
                 }
             })
             .else_([](auto) noexcept
@@ -274,9 +300,9 @@ public:
         return *this;
     }
 
-    option& operator= (option&& that) noexcept(std::is_nothrow_move_assignable_v<T>    &&
-                                               std::is_nothrow_move_constructible_v<T> &&
-                                               std::is_nothrow_destructible_v<T>)
+    option_value& operator= (option_value&& that) noexcept(std::is_nothrow_move_assignable_v<T>    &&
+                                                           std::is_nothrow_move_constructible_v<T> &&
+                                                           std::is_nothrow_destructible_v<T>)
     {
         constexpr_if<std::is_move_constructible_v<T> && std::is_move_assignable_v<T>>()
             .then([&](auto) noexcept(std::is_nothrow_move_assignable_v<T>    &&
@@ -285,9 +311,9 @@ public:
             {
                 if (!(empty() && that.empty()))
                 {
-                    if (non_empty() && that.non_empty())   assign(std::move(that).value());
-                    else if (empty() && that.non_empty())  initialize(std::move(that).value());
-                    else                                   reset();
+                    if (!empty() && !that.empty())   get() = std::move(that.get());
+                    else if (empty())                initialize(std::move(that.get()));
+                    else                             reset();
                 }
             })
             .else_([](auto) noexcept
@@ -298,6 +324,191 @@ public:
         return *this;
     }
 
+    void* pointer() noexcept
+    {
+        return storage.pointer();
+    }
+
+    const void* pointer() const noexcept
+    {
+        return storage.pointer();
+    }
+
+    bool empty() const noexcept
+    {
+        return storage.empty();
+    }
+
+    template <typename... Args>
+    void initialize(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+    {
+        new (pointer()) T(std::forward<Args>(args)...);
+        storage.set_empty(false);
+    }
+
+    void reset() noexcept(std::is_nothrow_destructible_v<T>)
+    {
+        destroy();
+        storage.set_empty(true);
+    }
+
+private:
+
+    T& get() noexcept
+    {
+        return *static_cast<T*>(pointer());
+    }
+
+    const T& get() const noexcept
+    {
+        return *static_cast<const T*>(pointer());
+    }
+
+    void destroy() noexcept(std::is_nothrow_destructible_v<T>)
+    {
+        if (!empty()) get().~T();
+    }
+
+    option_storage<T> storage;
+};
+
+template <typename T>
+class option_value<T, true> final
+{
+public:
+
+    option_value() noexcept
+        : storage()
+    {
+    }
+
+    void* pointer() noexcept
+    {
+        return storage.pointer();
+    }
+
+    const void* pointer() const noexcept
+    {
+        return storage.pointer();
+    }
+
+    bool empty() const noexcept
+    {
+        return storage.empty();
+    }
+
+    template <typename... Args>
+    void initialize(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+    {
+        new (pointer()) T(std::forward<Args>(args)...);
+        storage.set_empty(false);
+    }
+
+    void reset() noexcept
+    {
+        storage.set_empty(true);
+    }
+
+private:
+
+    option_storage<T> storage;
+};
+
+} // detail namespace
+
+template <typename T>
+class option final
+{
+
+    static_assert(!std::is_const_v<T>, "Optional type shouldn't be const. Use 'const option<T>' declaration instead.");
+    static_assert(!std::is_volatile_v<T>, "Optional type shouldn't be volatile. Use 'volatile option<T>' declaration instead.");
+    static_assert(!std::is_rvalue_reference_v<T>, "Optional type shouldn't be a rvalue reference.");
+    static_assert(!std::is_void_v<T>, "Option can't hold a value of 'void' type.");
+    static_assert(!std::is_array_v<T>, "Option can't hold a value of array type.");
+    static_assert(std::is_destructible_v<T>, "Optional type should be destructible");
+public:
+
+    using value_type = T;
+    using iterator = option_iterator<T>;
+    using const_iterator = const_option_iterator<T>;
+    using reverse_iterator = iterator;
+    using const_reverse_iterator = const_iterator;
+    
+    option() noexcept
+        : storage()
+    {
+    }
+    
+    explicit option(const none_t&) noexcept
+        : option()
+    {
+    }
+    
+    explicit option(const T& that) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        : storage()
+    {
+        constexpr_if<std::is_copy_constructible_v<T>>()
+            .then([&](auto) noexcept(std::is_nothrow_copy_constructible_v<T>)
+            {
+                initialize(that);
+            })
+            .else_([](auto) noexcept
+            {
+                static_assert(false, "Optional type should be copy constructible");
+            })(nothing);
+    }
+    
+    explicit option(T&& that) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : storage()
+    {
+        constexpr_if<std::is_move_constructible_v<T>>()
+            .then([&](auto) noexcept(std::is_nothrow_move_constructible_v<T>)
+            {
+                initialize(std::move(that));
+            })
+            .else_([](auto) noexcept
+            {
+                static_assert(false, "Optional type should be move constructible");
+            })(nothing);
+    }
+    
+    option(const option&) = default;
+    option(option&&) = default;
+
+    // NOTE: an option of a reference converts to an option of the referenced value (e.g. when results are collected)
+    template <typename U, typename = std::enable_if_t<std::is_constructible_v<T, U&>>>
+    option(const option<U&>& that) noexcept(std::is_nothrow_constructible_v<T, U&>)
+        : storage()
+    {
+        if (that.non_empty()) initialize(that.get());
+    }
+
+    template <typename... Args>
+    explicit option(in_place_t, Args&&... arguments) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+        : storage()
+    {
+        constexpr_if<std::is_constructible_v<T, Args...>>()
+            .then([this](auto&&... args) noexcept(std::is_nothrow_constructible_v<T, decltype(args)...>)
+            {
+                initialize(std::forward<decltype(args)>(args)...);
+            })
+            .else_([](auto...) noexcept
+            {
+                static_assert(false, "Optional type should be constructible from 'Ts&&...'");
+            })(std::forward<Args>(arguments)...);
+    }
+    
+    ~option() = default;
+    
+    option& operator= (const none_t&) noexcept(std::is_nothrow_destructible_v<T>)
+    {
+        reset();
+        return *this;
+    }
+
+    option& operator= (const option&) = default;
+    option& operator= (option&&) = default;
+
     option& operator= (const T& that) noexcept(std::is_nothrow_copy_assignable_v<T> && std::is_nothrow_copy_constructible_v<T>)
     {
         constexpr_if<std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>>()
@@ -332,8 +543,7 @@ public:
     
     void reset() noexcept(std::is_nothrow_destructible_v<T>)
     {
-        destroy();
-        emptyFlag = true;
+        storage.reset();
     }
     
     bool operator== (const none_t&) const noexcept
@@ -391,9 +601,8 @@ public:
             .then([this](auto&&... args) noexcept(std::is_nothrow_destructible_v<T> &&
                                                   std::is_nothrow_constructible_v<T, decltype(args)...>)
             {
-                destroy();
-                construct(std::forward<decltype(args)>(args)...);
-                emptyFlag = false;
+                reset();
+                initialize(std::forward<decltype(args)>(args)...);
             })
             .else_([](auto...) noexcept
             {
@@ -406,8 +615,8 @@ public:
         return empty() ? size_t(0) : size_t(1);
     }
     
-    bool empty() const noexcept { return emptyFlag; }
-    bool non_empty() const noexcept { return !emptyFlag; }
+    bool empty() const noexcept { return storage.empty(); }
+    bool non_empty() const noexcept { return !storage.empty(); }
     
     const T& get() const & noexcept
     {
@@ -637,12 +846,12 @@ private:
 
     const T* pointer() const noexcept
     {
-        return reinterpret_cast<const T*>(std::addressof(storage));
+        return static_cast<const T*>(storage.pointer());
     }
     
     T* pointer() noexcept
     {
-        return reinterpret_cast<T*>(std::addressof(storage));
+        return static_cast<T*>(storage.pointer());
     }
     
     const T* pointer_or_null() const noexcept
@@ -665,17 +874,10 @@ private:
         return *pointer();
     }
     
-    template <typename... Ts>
-    void construct(Ts&&... args) noexcept(std::is_nothrow_constructible_v<T, Ts...>)
-    {
-        new (pointer()) T(std::forward<Ts>(args)...);
-    }
-    
     template <typename... Ts>
     void initialize(Ts&&... args) noexcept(std::is_nothrow_constructible_v<T, Ts...>)
     {
-        construct(std::forward<Ts>(args)...);
-        emptyFlag = false;
+        storage.initialize(std::forward<Ts>(args)...);
     }
     
     template <typename U>
@@ -684,24 +886,7 @@ private:
         value() = std::forward<U>(object);
     }
     
-    template <typename U>
-    static auto destroy(U*) noexcept -> std::enable_if_t<std::is_trivially_destructible_v<U>>
-    {
-    }
-    
-    template <typename U>
-    static auto destroy(U* object) noexcept(std::is_nothrow_destructible_v<U>) -> std::enable_if_t<!std::is_trivially_destructible_v<U>>
-    {
-        object->~U();
-    }
-    
-    void destroy() noexcept(noexcept(destroy(pointer())))
-    {
-        if (non_empty()) destroy(pointer());
-    }
-    
-    std::aligned_storage_t<sizeof(T), alignof(T)> storage;
-    bool emptyFlag;
+    detail::option_value<T> storage;
 };
 
 template <typename T>
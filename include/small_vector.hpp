@@ -0,0 +1,378 @@
+#pragma once
+
+#include "detail/scope_guard.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+// NOTE: a vector which keeps up to N elements in the inline storage and moves them to the allocated memory
+//       when it grows past N. reserve allocates exactly the requested capacity, so a known size is allocated once
+template <typename T, size_t N, typename Allocator = std::allocator<T>>
+class small_vector final
+{
+    using allocator_type_traits = std::allocator_traits<typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+public:
+
+    using value_type = T;
+    using allocator_type = typename allocator_type_traits::allocator_type;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr size_t inline_capacity = N;
+
+    // NOTE: the inline storage is left uninitialized, only the constructed elements are touched
+    explicit small_vector(const allocator_type& alloc = allocator_type()) noexcept
+        : alloc(alloc),
+          first(inline_data()),
+          count(0),
+          reserved(N)
+    {
+    }
+
+    small_vector(std::initializer_list<T> values, const allocator_type& alloc = allocator_type())
+        : small_vector(alloc)
+    {
+        reserve(values.size());
+        for (const auto& value : values)
+            emplace_back(value);
+    }
+
+    small_vector(const small_vector& that)
+        : small_vector(allocator_type_traits::select_on_container_copy_construction(that.alloc))
+    {
+        reserve(that.size());
+        for (const auto& value : that)
+            emplace_back(value);
+    }
+
+    small_vector(small_vector&& that) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : small_vector(that.alloc)
+    {
+        steal(that);
+    }
+
+    ~small_vector() noexcept
+    {
+        clear();
+        release();
+    }
+
+    small_vector& operator= (const small_vector& that)
+    {
+        if (this != &that)
+        {
+            clear();
+            reserve(that.size());
+            for (const auto& value : that)
+                emplace_back(value);
+        }
+
+        return *this;
+    }
+
+    small_vector& operator= (small_vector&& that) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &that)
+        {
+            clear();
+            release();
+            alloc = that.alloc;
+            steal(that);
+        }
+
+        return *this;
+    }
+
+    void reserve(const size_t capacity)
+    {
+        if (capacity > reserved) relocate(capacity);
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (count != reserved)
+        {
+            auto* result = ::new (static_cast<void*>(first + count)) T(std::forward<Args>(args)...);
+            ++count;
+            return *result;
+        }
+
+        // NOTE: the new element is constructed before the relocation, the arguments may refer to the elements
+        const auto capacity = std::max(reserved * 2, size_t(N + 1));
+        auto* memory = allocator_type_traits::allocate(alloc, capacity);
+        {
+            EXSTREAM_SCOPE_FAIL
+            {
+                allocator_type_traits::deallocate(alloc, memory, capacity);
+            };
+
+            ::new (static_cast<void*>(memory + count)) T(std::forward<Args>(args)...);
+            EXSTREAM_SCOPE_FAIL
+            {
+                memory[count].~T();
+            };
+
+            move_to(memory);
+        }
+
+        release();
+        first = memory;
+        reserved = capacity;
+        ++count;
+        return first[count - 1];
+    }
+
+    void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    // NOTE: a range of a known size is appended with a single growth
+    template <typename InputIter>
+    void append(InputIter from, InputIter to)
+    {
+        append(from, to, typename std::iterator_traits<InputIter>::iterator_category());
+    }
+
+    void pop_back() noexcept
+    {
+        assert(!empty() && "Small vector is empty");
+
+        --count;
+        first[count].~T();
+    }
+
+    // NOTE: keeps the allocated memory
+    void clear() noexcept
+    {
+        while (count != 0)
+            pop_back();
+    }
+
+    size_t size() const noexcept
+    {
+        return count;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return reserved;
+    }
+
+    bool empty() const noexcept
+    {
+        return count == 0;
+    }
+
+    bool is_inline() const noexcept
+    {
+        return first == inline_data();
+    }
+
+    allocator_type get_allocator() const noexcept
+    {
+        return alloc;
+    }
+
+    T* data() noexcept
+    {
+        return first;
+    }
+
+    const T* data() const noexcept
+    {
+        return first;
+    }
+
+    T& operator[] (const size_t index) noexcept
+    {
+        assert(index < count && "Index is out of range");
+        return first[index];
+    }
+
+    const T& operator[] (const size_t index) const noexcept
+    {
+        assert(index < count && "Index is out of range");
+        return first[index];
+    }
+
+    T& front() noexcept
+    {
+        return (*this)[0];
+    }
+
+    const T& front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    T& back() noexcept
+    {
+        return (*this)[count - 1];
+    }
+
+    const T& back() const noexcept
+    {
+        return (*this)[count - 1];
+    }
+
+    iterator begin() noexcept
+    {
+        return first;
+    }
+
+    iterator end() noexcept
+    {
+        return first + count;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return first;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return first + count;
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    bool operator== (const small_vector& that) const
+    {
+        return std::equal(begin(), end(), that.begin(), that.end());
+    }
+
+    bool operator!= (const small_vector& that) const
+    {
+        return !(*this == that);
+    }
+
+private:
+
+    T* inline_data() noexcept
+    {
+        return reinterpret_cast<T*>(std::addressof(storage));
+    }
+
+    const T* inline_data() const noexcept
+    {
+        return reinterpret_cast<const T*>(std::addressof(storage));
+    }
+
+    template <typename InputIter>
+    void append(InputIter from, InputIter to, std::input_iterator_tag)
+    {
+        for (; from != to; ++from)
+            emplace_back(*from);
+    }
+
+    template <typename ForwardIter>
+    void append(ForwardIter from, ForwardIter to, std::forward_iterator_tag)
+    {
+        const auto size = count + size_t(std::distance(from, to));
+        if (size > reserved) relocate(std::max(size, reserved * 2));
+
+        std::uninitialized_copy(from, to, end());
+        count = size;
+    }
+
+    // NOTE: the allocated memory is taken over, the inline elements are moved one by one
+    void steal(small_vector& that) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (that.is_inline())
+        {
+            for (auto& value : that)
+                emplace_back(std::move(value));
+
+            that.clear();
+            return;
+        }
+
+        first = std::exchange(that.first, that.inline_data());
+        count = std::exchange(that.count, size_t(0));
+        reserved = std::exchange(that.reserved, N);
+    }
+
+    void relocate(const size_t capacity)
+    {
+        auto* memory = allocator_type_traits::allocate(alloc, capacity);
+        {
+            EXSTREAM_SCOPE_FAIL
+            {
+                allocator_type_traits::deallocate(alloc, memory, capacity);
+            };
+
+            move_to(memory);
+        }
+
+        release();
+        first = memory;
+        reserved = capacity;
+    }
+
+    // NOTE: the elements are moved if the move can't throw, otherwise they are copied and the vector is intact on failure
+    void move_to(T* memory)
+    {
+        size_t moved = 0;
+        EXSTREAM_SCOPE_FAIL
+        {
+            for (size_t i = 0; i < moved; ++i)
+                memory[i].~T();
+        };
+
+        for (; moved < count; ++moved)
+            ::new (static_cast<void*>(memory + moved)) T(std::move_if_noexcept(first[moved]));
+
+        for (size_t i = 0; i < count; ++i)
+            first[i].~T();
+    }
+
+    // NOTE: frees the allocated memory of the destroyed elements
+    void release() noexcept
+    {
+        if (!is_inline())
+            allocator_type_traits::deallocate(alloc, first, reserved);
+
+        first = inline_data();
+        reserved = N;
+    }
+
+    std::aligned_storage_t<sizeof(T) * (N == 0 ? 1 : N), alignof(T)> storage;
+    allocator_type alloc;
+    T* first;
+    size_t count;
+    size_t reserved;
+};
+
+} // exstream namespace
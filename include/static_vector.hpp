@@ -0,0 +1,240 @@
+#pragma once
+
+#include "config.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+// NOTE: a vector of at most N elements in the inline storage, it never allocates.
+//       Appending to a full vector is an error, check full() before
+template <typename T, size_t N>
+class static_vector final
+{
+public:
+
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    // NOTE: the storage is left uninitialized, only the constructed elements are touched
+    static_vector() noexcept
+        : count(0)
+    {
+    }
+
+    static_vector(std::initializer_list<T> values)
+        : static_vector()
+    {
+        assert(values.size() <= N && "Static vector capacity is exceeded");
+
+        for (const auto& value : values)
+            emplace_back(value);
+    }
+
+    static_vector(const static_vector& that)
+        : static_vector()
+    {
+        for (const auto& value : that)
+            emplace_back(value);
+    }
+
+    static_vector(static_vector&& that) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : static_vector()
+    {
+        for (auto& value : that)
+            emplace_back(std::move(value));
+    }
+
+    ~static_vector() noexcept
+    {
+        clear();
+    }
+
+    static_vector& operator= (const static_vector& that)
+    {
+        if (this != &that)
+        {
+            clear();
+            for (const auto& value : that)
+                emplace_back(value);
+        }
+
+        return *this;
+    }
+
+    static_vector& operator= (static_vector&& that) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &that)
+        {
+            clear();
+            for (auto& value : that)
+                emplace_back(std::move(value));
+        }
+
+        return *this;
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        assert(!full() && "Static vector capacity is exceeded");
+
+        auto* result = ::new (static_cast<void*>(data() + count)) T(std::forward<Args>(args)...);
+        ++count;
+        return *result;
+    }
+
+    void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() noexcept
+    {
+        assert(!empty() && "Static vector is empty");
+
+        --count;
+        data()[count].~T();
+    }
+
+    void clear() noexcept
+    {
+        while (count != 0)
+            pop_back();
+    }
+
+    size_t size() const noexcept
+    {
+        return count;
+    }
+
+    bool empty() const noexcept
+    {
+        return count == 0;
+    }
+
+    bool full() const noexcept
+    {
+        return count == N;
+    }
+
+    static constexpr size_t capacity() noexcept
+    {
+        return N;
+    }
+
+    static constexpr size_t max_size() noexcept
+    {
+        return N;
+    }
+
+    T* data() noexcept
+    {
+        return reinterpret_cast<T*>(std::addressof(storage));
+    }
+
+    const T* data() const noexcept
+    {
+        return reinterpret_cast<const T*>(std::addressof(storage));
+    }
+
+    T& operator[] (const size_t index) noexcept
+    {
+        assert(index < count && "Index is out of range");
+        return data()[index];
+    }
+
+    const T& operator[] (const size_t index) const noexcept
+    {
+        assert(index < count && "Index is out of range");
+        return data()[index];
+    }
+
+    T& front() noexcept
+    {
+        return (*this)[0];
+    }
+
+    const T& front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    T& back() noexcept
+    {
+        return (*this)[count - 1];
+    }
+
+    const T& back() const noexcept
+    {
+        return (*this)[count - 1];
+    }
+
+    iterator begin() noexcept
+    {
+        return data();
+    }
+
+    iterator end() noexcept
+    {
+        return data() + count;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return data();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return data() + count;
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    bool operator== (const static_vector& that) const
+    {
+        return std::equal(begin(), end(), that.begin(), that.end());
+    }
+
+    bool operator!= (const static_vector& that) const
+    {
+        return !(*this == that);
+    }
+
+private:
+
+    std::aligned_storage_t<sizeof(T) * (N == 0 ? 1 : N), alignof(T)> storage;
+    size_t count;
+};
+
+} // exstream namespace
@@ -52,7 +52,7 @@ template <typename Allocator, typename Meta, typename Iterator>
 using stream_type = stream<
     typename std::decay_t<Iterator>::value_type,
     std::decay_t<Iterator>,
-    Allocator,
+    instrumentation::allocator_t<Allocator>,
     Meta
 >;
 
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "stream.hpp"
+#include "detail/traits.hpp"
+#include "meta_info.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <iterator>
+#include <tuple>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+
+// NOTE: rows are tuples of references to the column elements, so untouched columns are never read
+template <typename... Iterators>
+class columns_iterator final
+{
+    using indices = std::index_sequence_for<Iterators...>;
+public:
+
+    using value_type = std::tuple<typename std::iterator_traits<Iterators>::value_type...>;
+    using result_type = std::tuple<typename std::iterator_traits<Iterators>::reference...>;
+
+    explicit columns_iterator(const size_t count, const Iterators&... iterators) noexcept(std::conjunction_v<std::is_nothrow_copy_constructible<Iterators>...>)
+        : iterators(iterators...),
+          count(count)
+    {
+    }
+
+    columns_iterator(const columns_iterator&) = default;
+    columns_iterator(columns_iterator&&) = default;
+
+    columns_iterator& operator= (const columns_iterator&) = delete;
+    columns_iterator& operator= (columns_iterator&&) = delete;
+
+    bool has_next() const noexcept
+    {
+        return count != 0;
+    }
+
+    result_type next()
+    {
+        assert(has_next() && "Iterator is out of range");
+        return next(indices());
+    }
+
+    void skip()
+    {
+        assert(has_next() && "Iterator is out of range");
+        skip(indices());
+    }
+
+    size_t elements_count() const noexcept
+    {
+        return count;
+    }
+
+private:
+
+    template <size_t... Indices>
+    result_type next(std::index_sequence<Indices...>)
+    {
+        result_type result(*std::get<Indices>(iterators)...);
+        skip(std::index_sequence<Indices...>());
+        return result;
+    }
+
+    template <size_t... Indices>
+    void skip(std::index_sequence<Indices...>)
+    {
+        (void)std::initializer_list<int>{ (void(++std::get<Indices>(iterators)), 0)... };
+        --count;
+    }
+
+    std::tuple<Iterators...> iterators;
+    size_t count;
+};
+
+} // detail namespace
+
+// NOTE: columns aren't copied and should outlive the stream, the shortest column limits the rows count
+template <typename... Columns>
+auto stream_of_columns(const Columns&... columns)
+{
+    static_assert(sizeof...(Columns) != 0, "At least one column is required");
+    static_assert(std::conjunction_v<is_iterable<Columns>...>, "Columns should meet 'Iterable' concept");
+    static_assert(std::conjunction_v<is_sizable<Columns>...>, "Columns should be sizable");
+
+    using meta = meta_info<false, false, Order::Unknown>;
+    using iterator_type = detail::columns_iterator<decltype(std::cbegin(columns))...>;
+
+    const size_t count = std::min({ static_cast<size_t>(columns.size())... });
+    return detail::make_stream<meta>(iterator_type(count, std::cbegin(columns)...), std::allocator<unsigned char>());
+}
+
+namespace detail {
+
+template <typename Columns, size_t... Indices>
+auto stream_of_columns(const Columns& columns, std::index_sequence<Indices...>)
+{
+    return exstream::stream_of_columns(std::get<Indices>(columns)...);
+}
+
+} // detail namespace
+
+template <typename... Columns>
+auto stream_of_columns(const std::tuple<Columns...>& columns)
+{
+    return detail::stream_of_columns(columns, std::index_sequence_for<Columns...>());
+}
+
+} // exstream namespace
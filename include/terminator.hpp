@@ -1,7 +1,12 @@
 #pragma once
 
 #include "detail/bool_c.hpp"
+#include "detail/consume.hpp"
 #include "utility.hpp"
+#include "iterator.hpp"
+#include "instrumentation.hpp"
+#include "aggregators/hyperloglog.hpp"
+#include "aggregators/space_saving.hpp"
 
 namespace exstream {
 namespace detail {
@@ -29,6 +34,64 @@ constexpr bool is_nothrow_elements_count() noexcept
     return noexcept(std::declval<const Self&>().get_iterator().elements_count());
 }
 
+struct element_wise_tag {};
+struct bulk_copy_tag {};
+struct bulk_insert_tag {};
+
+template <typename OutputIter, typename RangeIter>
+struct is_range_back_inserter : std::false_type {};
+
+template <typename Container, typename RangeIter>
+struct is_range_back_inserter<std::back_insert_iterator<Container>, RangeIter>
+    : detail::has_insert_method<Container&, typename Container::const_iterator, RangeIter, RangeIter>
+{
+};
+
+template <typename Iterator, typename OutputIter>
+struct fill_strategy
+{
+    using type = element_wise_tag;
+};
+
+template <typename RangeIter, typename OutputIter>
+struct fill_strategy<iterator<RangeIter, RangeIter>, OutputIter>
+{
+    using type = std::conditional_t<
+        !is_forward_iterator_v<RangeIter>,
+        element_wise_tag,
+        std::conditional_t<is_range_back_inserter<OutputIter, RangeIter>::value, bulk_insert_tag, bulk_copy_tag>
+    >;
+};
+
+template <typename Iterator, typename OutputIter>
+using fill_strategy_t = typename fill_strategy<Iterator, OutputIter>::type;
+
+template <typename Builder, typename Iterator>
+struct is_range_appendable : std::false_type {};
+
+template <typename Builder, typename RangeIter>
+struct is_range_appendable<Builder, iterator<RangeIter, RangeIter>> : std::conjunction<
+    is_forward_iterator<RangeIter>,
+    detail::has_append_range_method<Builder&, RangeIter, RangeIter>
+>
+{
+};
+
+// NOTE: back_insert_iterator keeps the container pointer in a protected member
+template <typename Container>
+Container& get_container(std::back_insert_iterator<Container>& outIter) noexcept
+{
+    struct accessor : std::back_insert_iterator<Container>
+    {
+        static Container& get(std::back_insert_iterator<Container>& iter) noexcept
+        {
+            return *(iter.*(&accessor::container));
+        }
+    };
+
+    return accessor::get(outIter);
+}
+
 }} // detail::terminate namespace
 
 template <typename T, typename Self>
@@ -45,6 +108,7 @@ public:
     size_t count() noexcept(detail::terminate::is_nothrow_skip<Self>() &&
                             detail::terminate::is_nothrow_elements_count<Self>())
     {
+        detail::instrumentation::pipeline_scope<typename Self::iterator_type> pipelineScope;
         auto iter = self().get_iterator();
         const auto elementsCount = iter.elements_count();
 
@@ -67,6 +131,12 @@ public:
         fill(std::forward<OutputIter>(outIter), is_output_iterator<std::decay_t<OutputIter>>());
     }
 
+    template <typename ForwardIter>
+    std::decay_t<ForwardIter> fill_n(ForwardIter&& outIter)
+    {
+        return fill_n(std::forward<ForwardIter>(outIter), is_forward_iterator<std::decay_t<ForwardIter>>());
+    }
+
     template <typename Collector>
     decltype(auto) collect(Collector&& collector)
     {
@@ -80,6 +150,25 @@ public:
         foreach(std::forward<Function>(function), is_invokable<Function, argument_type>());
     }
 
+    // NOTE: adds all elements to the aggregator and returns it, see aggregators.hpp
+    template <typename Aggregator>
+    auto aggregate(Aggregator&& aggregator)
+    {
+        return aggregate(std::forward<Aggregator>(aggregator), is_aggregator<std::decay_t<Aggregator>, T>());
+    }
+
+    // NOTE: the estimation of the distinct elements count in 2^precision bytes, see hyperloglog
+    size_t approx_distinct_count(const uint32_t precision = hyperloglog::default_precision)
+    {
+        return aggregate(hyperloglog(precision)).count();
+    }
+
+    // NOTE: the k most frequent elements with their counts in k counters, see space_saving
+    std::vector<heavy_hitter<T>> heavy_hitters(const size_t k)
+    {
+        return aggregate(space_saving<T>(k)).top();
+    }
+
 private:
 
     const Self& self() const noexcept
@@ -90,12 +179,41 @@ private:
     template <typename OutputIter>
     void fill(OutputIter&& outIter, std::true_type /* is output iterator */)
     {
+        using iterator_type = typename Self::iterator_type;
+
+        detail::instrumentation::pipeline_scope<iterator_type> pipelineScope;
         auto iter = self().get_iterator();
-        while (iter.has_next())
+        fill(iter, outIter, detail::terminate::fill_strategy_t<iterator_type, std::decay_t<OutputIter>>());
+    }
+
+    template <typename Iterator, typename OutputIter>
+    static void fill(Iterator& iter, OutputIter& outIter, detail::terminate::element_wise_tag)
+    {
+        consume(iter, [&](auto&& value)
         {
-            *outIter = iter.next();
+            *outIter = std::forward<decltype(value)>(value);
             ++outIter;
-        }
+        });
+    }
+
+    template <typename Iterator, typename OutputIter>
+    static void fill(Iterator& iter, OutputIter& outIter, detail::terminate::bulk_copy_tag)
+    {
+        outIter = iter.take_range([&](auto first, auto last)
+        {
+            return detail::bulk_copy(first, last, outIter);
+        });
+    }
+
+    template <typename Iterator, typename OutputIter>
+    static void fill(Iterator& iter, OutputIter& outIter, detail::terminate::bulk_insert_tag)
+    {
+        auto& container = detail::terminate::get_container(outIter);
+
+        iter.take_range([&](auto first, auto last)
+        {
+            container.insert(std::end(container), first, last);
+        });
     }
 
     template <typename OutputIter>
@@ -104,22 +222,85 @@ private:
         static_assert(false_v<OutputIter>, "Output iterator expected");
     }
 
+    template <typename ForwardIter>
+    std::decay_t<ForwardIter> fill_n(ForwardIter&& outIter, std::true_type /* is forward iterator */)
+    {
+        using iterator_type = typename Self::iterator_type;
+
+        detail::instrumentation::pipeline_scope<iterator_type> pipelineScope;
+        auto iter = self().get_iterator();
+        std::decay_t<ForwardIter> result(std::forward<ForwardIter>(outIter));
+
+        fill_n(iter, result, is_bulk_iterator<iterator_type>());
+        return result;
+    }
+
+    template <typename ForwardIter>
+    std::decay_t<ForwardIter> fill_n(ForwardIter&& outIter, std::false_type /* is forward iterator */) const noexcept
+    {
+        static_assert(false_v<ForwardIter>, "Forward iterator expected");
+        return outIter;
+    }
+
+    template <typename Iterator, typename ForwardIter>
+    static void fill_n(Iterator& iter, ForwardIter& outIter, std::true_type /* is bulk iterator */)
+    {
+        fill(iter, outIter, detail::terminate::bulk_copy_tag());
+    }
+
+    template <typename Iterator, typename ForwardIter>
+    static void fill_n(Iterator& iter, ForwardIter& outIter, std::false_type /* is bulk iterator */)
+    {
+        fill(iter, outIter, detail::terminate::element_wise_tag());
+    }
+
     template <typename Collector>
     decltype(auto) collect(Collector&& collector, std::true_type /* is valid collector */)
     {
-        auto builder = collector.builder(type_t<T>());
+        using iterator_type = typename Self::iterator_type;
+
+        detail::instrumentation::pipeline_scope<iterator_type> pipelineScope;
+        auto builder = make_builder(collector, detail::has_builder_method<Collector&, type_t<T>, const typename Self::allocator&>());
         auto iter = self().get_iterator();
 
         const auto elementsCount = iter.elements_count();
         if (elementsCount != unknown_count)
             builder.reserve(elementsCount);
 
-        while (iter.has_next())
-            builder.append(iter.next());
-
+        append(builder, iter, detail::terminate::is_range_appendable<decltype(builder), iterator_type>());
         return builder.build();
     }
 
+    template <typename Collector>
+    auto make_builder(Collector& collector, std::true_type /* uses the stream allocator */) const
+    {
+        return collector.builder(type_t<T>(), self().get_allocator());
+    }
+
+    template <typename Collector>
+    auto make_builder(Collector& collector, std::false_type /* uses the stream allocator */) const
+    {
+        return collector.builder(type_t<T>());
+    }
+
+    template <typename Builder, typename Iterator>
+    static void append(Builder& builder, Iterator& iter, std::true_type /* is range appendable */)
+    {
+        iter.take_range([&](auto first, auto last)
+        {
+            builder.append_range(first, last);
+        });
+    }
+
+    template <typename Builder, typename Iterator>
+    static void append(Builder& builder, Iterator& iter, std::false_type /* is range appendable */)
+    {
+        consume(iter, [&](auto&& value)
+        {
+            builder.append(std::forward<decltype(value)>(value));
+        });
+    }
+
     template <typename Collector>
     int collect(Collector&&, std::false_type /* is valid collector */) const noexcept
     {
@@ -130,10 +311,9 @@ private:
     template <typename Function>
     void foreach(Function&& function, std::true_type /* is callable */)
     {
+        detail::instrumentation::pipeline_scope<typename Self::iterator_type> pipelineScope;
         auto iter = self().get_iterator();
-
-        while (iter.has_next())
-            function(iter.next());
+        consume(iter, function);
     }
 
     template <typename Function>
@@ -141,6 +321,33 @@ private:
     {
         static_assert(false_v<Function>, "Invalid function");
     }
+
+    template <typename Aggregator>
+    std::decay_t<Aggregator> aggregate(Aggregator&& aggregator, std::true_type /* is valid aggregator */)
+    {
+        detail::instrumentation::pipeline_scope<typename Self::iterator_type> pipelineScope;
+        std::decay_t<Aggregator> result(std::forward<Aggregator>(aggregator));
+        auto iter = self().get_iterator();
+        consume(iter, [&](auto&& value)
+        {
+            result.add(std::forward<decltype(value)>(value));
+        });
+
+        return result;
+    }
+
+    template <typename Aggregator>
+    int aggregate(Aggregator&&, std::false_type /* is valid aggregator */) const noexcept
+    {
+        static_assert(false_v<Aggregator>, "Invalid aggregator");
+        return detail::terminate::suppress_unnecessary_error;
+    }
+
+    template <typename Iterator, typename Function>
+    static void consume(Iterator& iter, Function&& function)
+    {
+        detail::consume(iter, function);
+    }
 };
 
 } // exstream namespace
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "transform_iterator.hpp"
+#include "variant.hpp"
+#include "meta_info.hpp"
+#include "detail/result_traits.hpp"
+#include "detail/scope_guard.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cassert>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+namespace alternative {
+
+// NOTE: rvalue variants give away their values, lvalue variants are unwrapped by reference
+template <typename Variant, typename T>
+using element_t = decltype(std::declval<Variant>().template get<T>());
+
+}} // detail::alternative namespace
+
+template <typename Iterator,
+          typename Meta,
+          typename T>
+class alternative_iterator final : public transform_iterator<Iterator>
+{
+    using variant_type = typename Iterator::result_type;
+    using traits = result_traits<detail::alternative::element_t<variant_type, T>>;
+
+    static constexpr size_t alternative_index = type_list_ops::index_of_v<typename detail::variant_traits_t<variant_type>::types, T>;
+public:
+
+    using value_type = typename traits::value_type;
+    using result_type = typename traits::result_type;
+    using meta = meta_info<false, false, Order::Unknown>;
+
+    template <typename Allocator>
+    explicit alternative_iterator(const Iterator& iterator, const Allocator&) noexcept(std::is_nothrow_copy_constructible_v<Iterator>)
+        : transform_iterator(iterator),
+          cache()
+    {
+    }
+
+    template <typename Allocator>
+    explicit alternative_iterator(Iterator&& iterator, const Allocator&) noexcept(std::is_nothrow_move_constructible_v<Iterator>)
+        : transform_iterator(std::move(iterator)),
+          cache()
+    {
+    }
+
+    alternative_iterator(const alternative_iterator&) = delete;
+    alternative_iterator(alternative_iterator&&) = default;
+
+    alternative_iterator& operator= (const alternative_iterator&) = delete;
+    alternative_iterator& operator= (alternative_iterator&&) = delete;
+
+    bool has_next()
+    {
+        if (cache.empty()) fetch();
+        return cache.non_empty();
+    }
+
+    result_type next()
+    {
+        if (cache.empty()) fetch();
+
+        assert(cache.non_empty() && "Iterator is out of range");
+        EXSTREAM_SCOPE_SUCCESS noexcept(std::is_nothrow_destructible_v<storage>)
+        {
+            cache.reset();
+        };
+        return cache.get().release();
+    }
+
+    void skip()
+    {
+        if (cache.empty()) fetch();
+
+        assert(cache.non_empty() && "Iterator is out of range");
+        cache.reset();
+    }
+
+    size_t elements_count() const noexcept
+    {
+        return unknown_count;
+    }
+
+    // NOTE: push mode used by the terminators, matching alternatives are passed straight to the sink
+    template <typename Sink>
+    void drain(Sink&& sink)
+    {
+        if (cache.non_empty())
+        {
+            sink(cache.get().release());
+            cache.reset();
+        }
+
+        while (iterator.has_next())
+        {
+            auto&& value = iterator.next();
+            if (value.index() == alternative_index)
+                sink(traits::unwrap(std::forward<decltype(value)>(value).template get<T>()));
+        }
+    }
+
+private:
+
+    using storage = typename traits::storage;
+
+    // NOTE: only the variant index is compared, alternatives aren't visited
+    void fetch()
+    {
+        while (iterator.has_next())
+        {
+            auto&& value = iterator.next();
+            if (value.index() == alternative_index)
+            {
+                cache.emplace(std::forward<decltype(value)>(value).template get<T>());
+                break;
+            }
+        }
+    }
+
+    option<storage> cache;
+};
+
+} // exstream namespace
@@ -0,0 +1,229 @@
+#pragma once
+
+#include "transform_iterator.hpp"
+#include "detail/consume.hpp"
+#include "detail/result_traits.hpp"
+#include "detail/scope_guard.hpp"
+#include "detail/spsc_queue.hpp"
+#include "option.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+namespace async {
+
+constexpr size_t default_capacity = 1024;
+constexpr size_t max_batch_size = 64;
+
+template <typename Executor>
+struct parameters final
+{
+    const Executor& executor;
+    size_t capacity;
+};
+
+// NOTE: thrown on the worker to stop the upstream when the consumer is destroyed before the end of the stream
+struct cancellation final {};
+
+// NOTE: the state shared by the worker and the consumer. The queued results may refer to the upstream state,
+//       so the upstream is destroyed by the consumer once the worker has finished and the queue is not read anymore
+template <typename Iterator, typename Allocator>
+class channel final
+{
+public:
+
+    using storage = typename result_traits<typename Iterator::result_type>::storage;
+
+    explicit channel(Iterator&& iterator, const size_t capacity, const Allocator& alloc)
+        : source(std::move(iterator)),
+          queue(capacity, std::min(capacity / 8, max_batch_size), alloc),
+          error(),
+          finished(false),
+          cancelled(false)
+    {
+    }
+
+    channel(const channel&) = delete;
+    channel(channel&&) = delete;
+
+    channel& operator= (const channel&) = delete;
+    channel& operator= (channel&&) = delete;
+
+    void produce() noexcept
+    {
+        try
+        {
+            detail::consume(source.get(), [this](auto&& value)
+            {
+                push(std::forward<decltype(value)>(value));
+            });
+        }
+        catch (const cancellation&)
+        {
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        queue.flush_push();
+        finished.store(true, std::memory_order_release);
+    }
+
+    size_t source_count() const
+    {
+        return source.get().elements_count();
+    }
+
+    option<Iterator> source;
+    spsc_queue<storage, Allocator> queue;
+    std::exception_ptr error;
+    std::atomic<bool> finished;
+    std::atomic<bool> cancelled;
+
+private:
+
+    template <typename Value>
+    void push(Value&& value)
+    {
+        while (!queue.try_push(std::forward<Value>(value)))
+        {
+            queue.flush_push();
+            if (cancelled.load(std::memory_order_acquire)) throw cancellation();
+            std::this_thread::yield();
+        }
+    }
+};
+
+}} // detail::async namespace
+
+template <typename Executor>
+struct is_transformation_parameter<detail::async::parameters<Executor>> : std::true_type {};
+
+// NOTE: a stage boundary, the upstream runs on the executor and passes its results through a bounded queue,
+//       so the upstream and the downstream stages overlap. Referenced results should stay valid while
+//       the upstream moves on, which holds for the elements of the source containers
+template <typename Iterator,
+          typename Parameters,
+          typename Meta,
+          typename Allocator>
+class async_iterator final
+{
+    using traits = result_traits<typename Iterator::result_type>;
+    using channel_t = detail::async::channel<Iterator, Allocator>;
+public:
+
+    using value_type = typename traits::value_type;
+    using result_type = typename traits::result_type;
+    using meta = Meta;
+
+    explicit async_iterator(const Iterator& iterator, const Parameters& parameters, const Allocator& alloc)
+        : async_iterator(Iterator(iterator), parameters, alloc)
+    {
+    }
+
+    explicit async_iterator(Iterator&& iterator, const Parameters& parameters, const Allocator& alloc)
+        : channel(std::allocate_shared<channel_t>(alloc, std::move(iterator), parameters.capacity, alloc)),
+          parameters(parameters),
+          total(channel->source_count()),
+          consumed(0),
+          started(false)
+    {
+    }
+
+    async_iterator(const async_iterator&) = delete;
+    async_iterator(async_iterator&&) = default;
+
+    async_iterator& operator= (const async_iterator&) = delete;
+    async_iterator& operator= (async_iterator&&) = delete;
+
+    ~async_iterator() noexcept
+    {
+        if (!started || !channel) return;
+
+        channel->cancelled.store(true, std::memory_order_release);
+        while (!channel->finished.load(std::memory_order_acquire))
+            std::this_thread::yield();
+
+        channel->source.reset();
+    }
+
+    bool has_next()
+    {
+        start();
+
+        for (;;)
+        {
+            if (channel->queue.front() != nullptr) return true;
+
+            if (channel->finished.load(std::memory_order_acquire))
+            {
+                if (channel->queue.front() != nullptr) return true;
+                if (channel->error) std::rethrow_exception(std::exchange(channel->error, nullptr));
+                return false;
+            }
+
+            channel->queue.flush_pop();
+            std::this_thread::yield();
+        }
+    }
+
+    result_type next()
+    {
+        const bool found = has_next();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        EXSTREAM_SCOPE_SUCCESS noexcept
+        {
+            channel->queue.pop();
+            ++consumed;
+        };
+        return channel->queue.front()->release();
+    }
+
+    void skip()
+    {
+        const bool found = has_next();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        channel->queue.pop();
+        ++consumed;
+    }
+
+    size_t elements_count() const noexcept
+    {
+        return (total == unknown_count) ? unknown_count : total - consumed;
+    }
+
+private:
+
+    void start()
+    {
+        if (started) return;
+
+        parameters.executor([state = channel]() noexcept
+        {
+            state->produce();
+        });
+        started = true;
+    }
+
+    std::shared_ptr<channel_t> channel;
+    Parameters parameters;
+    size_t total;
+    size_t consumed;
+    bool started;
+};
+
+} // exstream namespace
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "transform_iterator.hpp"
+#include "option.hpp"
+#include "meta_info.hpp"
+#include "detail/result_traits.hpp"
+#include "detail/scope_guard.hpp"
+#include "aggregators/bloom_filter.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <cassert>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+namespace bloom {
+
+constexpr size_t default_expected_count = size_t(1) << 20;
+
+struct parameters final
+{
+    double fpRate;
+    size_t expectedCount; // the filter size limit, it's used as is if the upstream count is unknown
+};
+
+}} // detail::bloom namespace
+
+template <>
+struct is_transformation_parameter<detail::bloom::parameters> : std::true_type {};
+
+// NOTE: drops the elements which are found in the bloom filter, so a repeated element is always dropped
+//       and a new one is dropped with the false positive rate. The memory is fixed by the filter size
+template <typename Iterator,
+          typename Parameters,
+          typename Meta,
+          typename Allocator>
+class bloom_distinct_iterator final : public transform_iterator<Iterator>
+{
+    using traits = result_traits<typename Iterator::result_type>;
+    using filter_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<uint64_t>;
+public:
+
+    using value_type = typename traits::value_type;
+    using result_type = typename traits::result_type;
+    using meta = meta_info<Meta::is_ordered, true, Meta::order>;
+
+    explicit bloom_distinct_iterator(const Iterator& iterator, const Parameters& parameters, const Allocator& alloc)
+        : transform_iterator(iterator),
+          cache(),
+          filter(filter_size(this->iterator, parameters), parameters.fpRate, filter_allocator(alloc))
+    {
+    }
+
+    explicit bloom_distinct_iterator(Iterator&& iterator, const Parameters& parameters, const Allocator& alloc)
+        : transform_iterator(std::move(iterator)),
+          cache(),
+          filter(filter_size(this->iterator, parameters), parameters.fpRate, filter_allocator(alloc))
+    {
+    }
+
+    bloom_distinct_iterator(const bloom_distinct_iterator&) = delete;
+    bloom_distinct_iterator(bloom_distinct_iterator&&) = default;
+
+    bloom_distinct_iterator& operator= (const bloom_distinct_iterator&) = delete;
+    bloom_distinct_iterator& operator= (bloom_distinct_iterator&&) = delete;
+
+    bool has_next()
+    {
+        if (cache.empty()) fetch();
+        return cache.non_empty();
+    }
+
+    result_type next()
+    {
+        if (cache.empty()) fetch();
+        assert(cache.non_empty() && "Iterator is out of range");
+
+        EXSTREAM_SCOPE_SUCCESS noexcept(std::is_nothrow_destructible_v<storage>)
+        {
+            cache.reset();
+        };
+        return cache.get().release();
+    }
+
+    void skip()
+    {
+        if (cache.empty()) fetch();
+        assert(cache.non_empty() && "Iterator is out of range");
+
+        cache.reset();
+    }
+
+    size_t elements_count() const noexcept
+    {
+        return unknown_count;
+    }
+
+private:
+
+    using storage = typename traits::storage;
+
+    static size_t filter_size(const Iterator& source, const Parameters& parameters)
+    {
+        const auto count = source.elements_count();
+        return (count == unknown_count) ? parameters.expectedCount : std::min(count, parameters.expectedCount);
+    }
+
+    void fetch()
+    {
+        while (iterator.has_next())
+        {
+            auto&& value = iterator.next();
+
+            if (filter.add(std::as_const(get_lvalue_reference(value))))
+            {
+                cache.emplace(std::forward<decltype(value)>(value));
+                break;
+            }
+        }
+    }
+
+    option<storage> cache;
+    bloom_filter<filter_allocator> filter;
+};
+
+} // exstream namespace
@@ -25,15 +25,15 @@ class distinct_iterator final : public transform_iterator<Iterator>
 public:
 
     using value_type = typename traits::value_type;
-    using result_type = typename traits::result_type;
+    // NOTE: set nodes are stable, so elements are handed out by reference for the whole iterator lifetime.
+    //       The elements stay in the set, so move-only elements pass through but can't be moved out downstream
+    using result_type = const value_type&;
     // TODO: maybe use simple set to preserve order???
     using meta = meta_info<false, true, Order::Ascending>; // TODO: custom comparator can change this
 
-    static_assert(std::is_copy_constructible_v<value_type>, "Distinct requires type to be a copy constructible in that case.");
-
     explicit distinct_iterator(const Iterator& iterator, const Allocator& alloc)
         : transform_iterator(iterator),
-          set(alloc),
+          set(set_allocator(alloc)),
           elementIter(std::end(set)),
           end(elementIter)
     {
@@ -42,7 +42,7 @@ public:
 
     explicit distinct_iterator(Iterator&& iterator, const Allocator& alloc)
         : transform_iterator(std::move(iterator)),
-          set(alloc),
+          set(set_allocator(alloc)),
           elementIter(std::end(set)),
           end(elementIter)
     {
@@ -65,12 +65,9 @@ public:
         assert(has_next() && "Iterator is out of range");
         if (!has_element()) fetch();
 
-        EXSTREAM_SCOPE_SUCCESS noexcept(noexcept(++std::declval<set_iterator>()))
-        {
-            ++elementIter;
-        };
-
-        return elementIter->copy();
+        result_type result = elementIter->get_ref();
+        elementIter = end;
+        return result;
     }
 
     void skip()
@@ -87,7 +84,8 @@ public:
 private:
 
     using storage = typename traits::storage;
-    using set_type = std::unordered_set<storage, std::hash<storage>, std::equal_to<storage>, Allocator>;
+    using set_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<storage>;
+    using set_type = std::unordered_set<storage, std::hash<storage>, std::equal_to<storage>, set_allocator>;
     using set_iterator = typename set_type::iterator;
 
     void init_set()
@@ -165,6 +163,11 @@ public:
         assert(has_next() && "Iterator is out of range");
         iterator.skip();
     }
+
+    size_t elements_count() const noexcept(noexcept(std::declval<Iterator&>().elements_count()))
+    {
+        return iterator.elements_count();
+    }
 };
 
 namespace detail {
@@ -183,6 +186,14 @@ constexpr bool is_nothrow_fetch() noexcept
            noexcept(std::declval<option<storage>&>().emplace(std::declval<result_type>()));
 }
 
+template <typename Iterator>
+constexpr bool is_nothrow_next() noexcept
+{
+    using storage = typename result_traits<typename Iterator::result_type>::storage;
+
+    return is_nothrow_fetch<Iterator>() && noexcept(std::declval<const storage&>().copy());
+}
+
 }} // detail::distinct namespace
 
 
@@ -198,6 +209,9 @@ public:
     using result_type = typename traits::result_type;
     using meta = meta_info<true, true, AnOrder>;
 
+    static_assert(std::is_reference_v<result_type> || std::is_copy_constructible_v<value_type>,
+                  "Distinct requires type to be a copy constructible in that case.");
+
     explicit distinct_iterator(const Iterator& iterator, const Allocator&) noexcept(std::is_nothrow_copy_constructible_v<Iterator>)
         : transform_iterator(iterator),
           cache(),
@@ -223,13 +237,14 @@ public:
         return iterator.has_next() || cache_has_value();
     }
 
-    result_type next() noexcept(detail::distinct::is_nothrow_fetch<Iterator>())
+    // NOTE: cached value is kept for the comparison with the following elements, so it's copied (lvalues are passed by reference)
+    result_type next() noexcept(detail::distinct::is_nothrow_next<Iterator>())
     {
         assert(has_next() && "Iterator is out of range");
 
         if (!cache_has_value()) fetch();
         EXSTREAM_SCOPE_EXIT noexcept { invalidate_cache(); };
-        return cache.get().release();
+        return cache.get().copy();
     }
 
     void skip() noexcept(detail::distinct::is_nothrow_fetch<Iterator>())
@@ -240,6 +255,11 @@ public:
         fetch();
     }
 
+    size_t elements_count() const noexcept
+    {
+        return unknown_count;
+    }
+
 private:
 
     using storage = typename traits::storage;
@@ -268,7 +288,7 @@ private:
         }
     }
 
-    void cache_has_value() const noexcept
+    bool cache_has_value() const noexcept
     {
         return cache.non_empty() && valid_cache;
     }
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "transform_iterator.hpp"
+#include "meta_info.hpp"
+#include "detail/consume.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cassert>
+#include <utility>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+
+template <typename Iterator,
+          typename Meta>
+class enumerate_iterator final : public transform_iterator<Iterator>
+{
+public:
+
+    using value_type = std::pair<size_t, typename Iterator::value_type>;
+    using result_type = std::pair<size_t, typename Iterator::result_type>;
+    // NOTE: pairs are compared by the index first, so the enumerated stream is always ascending
+    using meta = meta_info<true, true, Order::Ascending>;
+
+    template <typename Allocator>
+    explicit enumerate_iterator(const Iterator& iterator, const Allocator&) noexcept(std::is_nothrow_copy_constructible_v<Iterator>)
+        : transform_iterator(iterator),
+          index(0)
+    {
+    }
+
+    template <typename Allocator>
+    explicit enumerate_iterator(Iterator&& iterator, const Allocator&) noexcept(std::is_nothrow_move_constructible_v<Iterator>)
+        : transform_iterator(std::move(iterator)),
+          index(0)
+    {
+    }
+
+    enumerate_iterator(const enumerate_iterator&) = delete;
+    enumerate_iterator(enumerate_iterator&&) = default;
+
+    enumerate_iterator& operator= (const enumerate_iterator&) = delete;
+    enumerate_iterator& operator= (enumerate_iterator&&) = delete;
+
+    bool has_next() noexcept(noexcept(std::declval<Iterator&>().has_next()))
+    {
+        return iterator.has_next();
+    }
+
+    result_type next()
+    {
+        assert(has_next() && "Iterator is out of range");
+        return result_type(index++, iterator.next());
+    }
+
+    void skip() noexcept(noexcept(std::declval<Iterator&>().skip()))
+    {
+        assert(has_next() && "Iterator is out of range");
+        ++index;
+        iterator.skip();
+    }
+
+    size_t elements_count() const noexcept(noexcept(std::declval<Iterator&>().elements_count()))
+    {
+        return iterator.elements_count();
+    }
+
+    // NOTE: push mode used by the terminators, keeps the upstream in the push mode as well
+    template <typename Sink>
+    void drain(Sink&& sink)
+    {
+        detail::consume(iterator, [&](auto&& value)
+        {
+            sink(result_type(index++, std::forward<decltype(value)>(value)));
+        });
+    }
+
+private:
+
+    size_t index;
+};
+
+} // exstream namespace
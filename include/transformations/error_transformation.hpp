@@ -16,6 +16,12 @@ struct error_transformation final
         return *this;
     }
 
+    template <typename T, typename Function>
+    const error_transformation& flat_map_into(const Function&) const noexcept
+    {
+        return *this;
+    }
+
     template <typename Function>
     const error_transformation& filter(const Function&) const noexcept
     {
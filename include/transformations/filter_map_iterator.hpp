@@ -0,0 +1,112 @@
+#pragma once
+
+#include "flatten_iterator.hpp"
+
+namespace exstream {
+
+template <typename Iterator,
+          typename Function,
+          typename Meta>
+class filter_map_iterator final : public transform_iterator<Iterator>
+{
+    using function_result = result_of_t<const Function&(typename Iterator::result_type)>;
+    using traits = result_traits<detail::flatten::element_t<function_result>>;
+public:
+
+    using value_type = typename traits::value_type;
+    using result_type = typename traits::result_type;
+    using meta = meta_info<false, false, Order::Unknown>;
+
+    template <typename Allocator>
+    explicit filter_map_iterator(const Iterator& iterator, const Function& function, const Allocator&) noexcept(std::is_nothrow_copy_constructible_v<Iterator>)
+        : transform_iterator(iterator),
+          cache(),
+          function(function)
+    {
+    }
+
+    template <typename Allocator>
+    explicit filter_map_iterator(Iterator&& iterator, const Function& function, const Allocator&) noexcept(std::is_nothrow_move_constructible_v<Iterator>)
+        : transform_iterator(std::move(iterator)),
+          cache(),
+          function(function)
+    {
+    }
+
+    filter_map_iterator(const filter_map_iterator&) = delete;
+    filter_map_iterator(filter_map_iterator&&) = default;
+
+    filter_map_iterator& operator= (const filter_map_iterator&) = delete;
+    filter_map_iterator& operator= (filter_map_iterator&&) = delete;
+
+    bool has_next()
+    {
+        if (cache.empty()) fetch();
+        return cache.non_empty();
+    }
+
+    result_type next()
+    {
+        if (cache.empty()) fetch();
+
+        assert(cache.non_empty() && "Iterator is out of range");
+        EXSTREAM_SCOPE_SUCCESS noexcept(std::is_nothrow_destructible_v<storage>)
+        {
+            cache.reset();
+        };
+        return cache.get().release();
+    }
+
+    void skip()
+    {
+        if (cache.empty()) fetch();
+
+        assert(cache.non_empty() && "Iterator is out of range");
+        cache.reset();
+    }
+
+    size_t elements_count() const noexcept
+    {
+        return unknown_count;
+    }
+
+    // NOTE: push mode used by the terminators, function results are unwrapped straight into the sink
+    template <typename Sink>
+    void drain(Sink&& sink)
+    {
+        if (cache.non_empty())
+        {
+            sink(cache.get().release());
+            cache.reset();
+        }
+
+        while (iterator.has_next())
+        {
+            auto&& result = function(iterator.next());
+            if (result.non_empty())
+                sink(traits::unwrap(std::forward<decltype(result)>(result).get()));
+        }
+    }
+
+private:
+
+    using storage = typename traits::storage;
+
+    void fetch()
+    {
+        while (iterator.has_next())
+        {
+            auto&& result = function(iterator.next());
+            if (result.non_empty())
+            {
+                cache.emplace(std::forward<decltype(result)>(result).get());
+                break;
+            }
+        }
+    }
+
+    option<storage> cache;
+    const Function& function;
+};
+
+} // exstream namespace
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "transform_iterator.hpp"
+#include "meta_info.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cassert>
+#include <memory>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+namespace flat_map {
+
+// NOTE: the sink is type erased, so the function gets the same emitter in the pull and in the push mode
+template <typename T>
+class emitter final
+{
+public:
+
+    template <typename Sink>
+    explicit emitter(Sink& sink) noexcept
+        : sink(const_cast<void*>(static_cast<const void*>(std::addressof(sink)))),
+          pushCopy(&push_copy<Sink>),
+          pushMove(&push_move<Sink>)
+    {
+    }
+
+    emitter(const emitter&) = delete;
+    emitter& operator= (const emitter&) = delete;
+
+    void operator() (const T& value)
+    {
+        pushCopy(sink, value);
+    }
+
+    void operator() (T&& value)
+    {
+        pushMove(sink, std::move(value));
+    }
+
+private:
+
+    template <typename Sink>
+    static void push_copy(void* sink, const T& value)
+    {
+        (*static_cast<Sink*>(sink))(value);
+    }
+
+    template <typename Sink>
+    static void push_move(void* sink, T&& value)
+    {
+        (*static_cast<Sink*>(sink))(std::move(value));
+    }
+
+    void* sink;
+    void (*pushCopy)(void*, const T&);
+    void (*pushMove)(void*, T&&);
+};
+
+template <typename T, typename Allocator>
+using scratch_buffer_t = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+template <typename T, typename Allocator>
+class scratch_sink final
+{
+    using buffer_t = scratch_buffer_t<T, Allocator>;
+public:
+
+    explicit scratch_sink(buffer_t& buffer) noexcept
+        : buffer(buffer)
+    {
+    }
+
+    scratch_sink(const scratch_sink&) = delete;
+    scratch_sink& operator= (const scratch_sink&) = delete;
+
+    void operator() (const T& value)
+    {
+        buffer.push_back(value);
+    }
+
+    void operator() (T&& value)
+    {
+        buffer.push_back(std::move(value));
+    }
+
+private:
+
+    buffer_t& buffer;
+};
+
+}} // detail::flat_map namespace
+
+template <typename Iterator,
+          typename Function,
+          typename Meta,
+          typename Allocator,
+          typename T>
+class flat_map_into_iterator final : public transform_iterator<Iterator>
+{
+    using buffer_t = detail::flat_map::scratch_buffer_t<T, Allocator>;
+    using buffer_allocator = typename buffer_t::allocator_type;
+    using sink_t = detail::flat_map::scratch_sink<T, Allocator>;
+    using emitter_t = detail::flat_map::emitter<T>;
+public:
+
+    using value_type = T;
+    using result_type = T;
+    using meta = meta_info<false, false, Order::Unknown>;
+
+    explicit flat_map_into_iterator(const Iterator& iterator, const Function& function, const Allocator& alloc)
+        : transform_iterator(iterator),
+          buffer(buffer_allocator(alloc)),
+          position(0),
+          function(function)
+    {
+    }
+
+    explicit flat_map_into_iterator(Iterator&& iterator, const Function& function, const Allocator& alloc)
+        : transform_iterator(std::move(iterator)),
+          buffer(buffer_allocator(alloc)),
+          position(0),
+          function(function)
+    {
+    }
+
+    flat_map_into_iterator(const flat_map_into_iterator&) = delete;
+    flat_map_into_iterator(flat_map_into_iterator&&) = default;
+
+    flat_map_into_iterator& operator= (const flat_map_into_iterator&) = delete;
+
+    bool has_next()
+    {
+        while (!buffer_has_next() && iterator.has_next()) fetch();
+        return buffer_has_next();
+    }
+
+    result_type next()
+    {
+        if (!buffer_has_next()) has_next();
+
+        assert(buffer_has_next() && "Iterator is out of range");
+        return std::move(buffer[position++]);
+    }
+
+    void skip()
+    {
+        if (!buffer_has_next()) has_next();
+
+        assert(buffer_has_next() && "Iterator is out of range");
+        ++position;
+    }
+
+    size_t elements_count() const noexcept
+    {
+        return unknown_count;
+    }
+
+    // NOTE: push mode used by the terminators, elements are passed to the sink without the scratch buffer
+    template <typename Sink>
+    void drain(Sink&& sink)
+    {
+        while (buffer_has_next())
+            sink(std::move(buffer[position++]));
+
+        emitter_t emit(sink);
+        while (iterator.has_next())
+            function(iterator.next(), emit);
+    }
+
+private:
+
+    bool buffer_has_next() const noexcept
+    {
+        return position != buffer.size();
+    }
+
+    void fetch()
+    {
+        buffer.clear();
+        position = 0;
+
+        sink_t sink(buffer);
+        emitter_t emit(sink);
+        function(iterator.next(), emit);
+    }
+
+    buffer_t buffer;
+    size_t position;
+    const Function& function;
+};
+
+} // exstream namespace
@@ -138,7 +138,7 @@ template <typename Iterator,
           typename Allocator>
 class flat_map_iterator final : public transform_iterator<Iterator>
 {
-    using function_result = std::result_of_t<const Function&(typename Iterator::result_type)>;
+    using function_result = result_of_t<const Function&(typename Iterator::result_type)>;
     using stream_t = typename result_traits<function_result>::value_type;
 
     using stream_hold_iterator = detail::flat_map::stream_hold_iterator<
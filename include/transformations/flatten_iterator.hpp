@@ -0,0 +1,124 @@
+#pragma once
+
+#include "transform_iterator.hpp"
+#include "option.hpp"
+#include "meta_info.hpp"
+#include "detail/result_traits.hpp"
+#include "detail/scope_guard.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cassert>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+namespace flatten {
+
+// NOTE: rvalue options give away their values, lvalue options are unwrapped by reference
+template <typename Option>
+using element_t = decltype(std::declval<Option>().get());
+
+}} // detail::flatten namespace
+
+template <typename Iterator,
+          typename Meta>
+class flatten_iterator final : public transform_iterator<Iterator>
+{
+    using option_type = typename Iterator::result_type;
+    using traits = result_traits<detail::flatten::element_t<option_type>>;
+public:
+
+    using value_type = typename traits::value_type;
+    using result_type = typename traits::result_type;
+    using meta = meta_info<false, false, Order::Unknown>;
+
+    template <typename Allocator>
+    explicit flatten_iterator(const Iterator& iterator, const Allocator&) noexcept(std::is_nothrow_copy_constructible_v<Iterator>)
+        : transform_iterator(iterator),
+          cache()
+    {
+    }
+
+    template <typename Allocator>
+    explicit flatten_iterator(Iterator&& iterator, const Allocator&) noexcept(std::is_nothrow_move_constructible_v<Iterator>)
+        : transform_iterator(std::move(iterator)),
+          cache()
+    {
+    }
+
+    flatten_iterator(const flatten_iterator&) = delete;
+    flatten_iterator(flatten_iterator&&) = default;
+
+    flatten_iterator& operator= (const flatten_iterator&) = delete;
+    flatten_iterator& operator= (flatten_iterator&&) = delete;
+
+    bool has_next()
+    {
+        if (cache.empty()) fetch();
+        return cache.non_empty();
+    }
+
+    result_type next()
+    {
+        if (cache.empty()) fetch();
+
+        assert(cache.non_empty() && "Iterator is out of range");
+        EXSTREAM_SCOPE_SUCCESS noexcept(std::is_nothrow_destructible_v<storage>)
+        {
+            cache.reset();
+        };
+        return cache.get().release();
+    }
+
+    void skip()
+    {
+        if (cache.empty()) fetch();
+
+        assert(cache.non_empty() && "Iterator is out of range");
+        cache.reset();
+    }
+
+    size_t elements_count() const noexcept
+    {
+        return unknown_count;
+    }
+
+    // NOTE: push mode used by the terminators, values are unwrapped straight into the sink
+    template <typename Sink>
+    void drain(Sink&& sink)
+    {
+        if (cache.non_empty())
+        {
+            sink(cache.get().release());
+            cache.reset();
+        }
+
+        while (iterator.has_next())
+        {
+            auto&& value = iterator.next();
+            if (value.non_empty())
+                sink(traits::unwrap(std::forward<decltype(value)>(value).get()));
+        }
+    }
+
+private:
+
+    using storage = typename traits::storage;
+
+    void fetch()
+    {
+        while (iterator.has_next())
+        {
+            auto&& value = iterator.next();
+            if (value.non_empty())
+            {
+                cache.emplace(std::forward<decltype(value)>(value).get());
+                break;
+            }
+        }
+    }
+
+    option<storage> cache;
+};
+
+} // exstream namespace
@@ -15,7 +15,7 @@ template <typename Iterator,
           typename Meta>
 class map_iterator final : public transform_iterator<Iterator>
 {
-    using traits = result_traits<std::result_of_t<const Function&(typename Iterator::result_type)>>;
+    using traits = result_traits<result_of_t<const Function&(typename Iterator::result_type)>>;
 public:
 
     using value_type = typename traits::value_type;
@@ -0,0 +1,299 @@
+#pragma once
+
+#include "transform_iterator.hpp"
+#include "detail/result_traits.hpp"
+#include "detail/type_traits.hpp"
+#include "meta_info.hpp"
+#include "option.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+namespace par_map {
+
+constexpr size_t default_batch_size = 64;
+
+inline size_t default_window() noexcept
+{
+    return std::max(2u, 2 * std::thread::hardware_concurrency());
+}
+
+template <typename Function, typename Executor>
+struct parameters final
+{
+    const Function& function;
+    const Executor& executor;
+    size_t batchSize;
+    size_t window;
+};
+
+// NOTE: the inputs and the results of a batch, the vectors are reused by the following batches
+template <typename Input, typename Output, typename Allocator>
+struct batch final
+{
+    using input_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Input>;
+    using output_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<option<Output>>;
+
+    batch(const size_t size, const Allocator& alloc)
+        : inputs(input_allocator(alloc)),
+          outputs(size, output_allocator(alloc)),
+          position(0),
+          error(),
+          done(false)
+    {
+        inputs.reserve(size);
+    }
+
+    std::vector<Input, input_allocator> inputs;
+    std::vector<option<Output>, output_allocator> outputs;
+    size_t position;
+    std::exception_ptr error;
+    bool done;
+};
+
+// NOTE: the batches in flight form a ring, they are dispatched and consumed in the same order,
+//       so the ring is the reorder buffer of the results completed out of order
+template <typename Input, typename Output, typename Allocator>
+class reorder_buffer final
+{
+public:
+
+    using batch_t = batch<Input, Output, Allocator>;
+
+    reorder_buffer(const size_t window, const size_t batchSize, const Allocator& alloc)
+        : batches(batch_allocator(alloc)),
+          mutex(),
+          condition()
+    {
+        batches.reserve(window);
+        for (size_t i = 0; i < window; ++i)
+            batches.emplace_back(batchSize, alloc);
+    }
+
+    reorder_buffer(const reorder_buffer&) = delete;
+    reorder_buffer(reorder_buffer&&) = delete;
+
+    reorder_buffer& operator= (const reorder_buffer&) = delete;
+    reorder_buffer& operator= (reorder_buffer&&) = delete;
+
+    template <typename Function>
+    void process(const size_t index, const Function& function) noexcept
+    {
+        auto& target = batches[index];
+
+        try
+        {
+            for (size_t i = 0; i < target.inputs.size(); ++i)
+                target.outputs[i].emplace(function(target.inputs[i].release()));
+        }
+        catch (...)
+        {
+            target.error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            target.done = true;
+        }
+        condition.notify_all();
+    }
+
+    batch_t& wait(const size_t index)
+    {
+        auto& target = batches[index];
+
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return target.done; });
+
+        return target;
+    }
+
+    batch_t& operator[] (const size_t index) noexcept
+    {
+        return batches[index];
+    }
+
+    const batch_t& operator[] (const size_t index) const noexcept
+    {
+        return batches[index];
+    }
+
+    size_t size() const noexcept
+    {
+        return batches.size();
+    }
+
+private:
+
+    using batch_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<batch_t>;
+
+    std::vector<batch_t, batch_allocator> batches;
+    std::mutex mutex;
+    std::condition_variable condition;
+};
+
+}} // detail::par_map namespace
+
+template <typename Function, typename Executor>
+struct is_transformation_parameter<detail::par_map::parameters<Function, Executor>> : std::true_type {};
+
+// NOTE: the upstream is read on the caller thread in batches, every batch is mapped by a task on the executor
+//       and the results are emitted in the upstream order, at most window batches are in flight
+template <typename Iterator,
+          typename Parameters,
+          typename Meta,
+          typename Allocator>
+class par_map_iterator final : public transform_iterator<Iterator>
+{
+    using input = typename result_traits<typename Iterator::result_type>::storage;
+    using function_t = remove_cvr_t<decltype(std::declval<const Parameters&>().function)>;
+    using output = std::decay_t<result_of_t<const function_t&(typename Iterator::result_type)>>;
+    using buffer_t = detail::par_map::reorder_buffer<input, output, Allocator>;
+public:
+
+    using value_type = output;
+    using result_type = output;
+    using meta = meta_info<false, false, Order::Unknown>;
+
+    explicit par_map_iterator(const Iterator& iterator, const Parameters& parameters, const Allocator& alloc)
+        : transform_iterator(iterator),
+          buffer(std::allocate_shared<buffer_t>(alloc, parameters.window, parameters.batchSize, alloc)),
+          parameters(parameters),
+          first(0),
+          inFlight(0)
+    {
+    }
+
+    explicit par_map_iterator(Iterator&& iterator, const Parameters& parameters, const Allocator& alloc)
+        : transform_iterator(std::move(iterator)),
+          buffer(std::allocate_shared<buffer_t>(alloc, parameters.window, parameters.batchSize, alloc)),
+          parameters(parameters),
+          first(0),
+          inFlight(0)
+    {
+    }
+
+    par_map_iterator(const par_map_iterator&) = delete;
+    par_map_iterator(par_map_iterator&&) = default;
+
+    par_map_iterator& operator= (const par_map_iterator&) = delete;
+    par_map_iterator& operator= (par_map_iterator&&) = delete;
+
+    // NOTE: the tasks reference the inputs and the function, so they are awaited even if the stream isn't finished
+    ~par_map_iterator() noexcept
+    {
+        if (!buffer) return;
+
+        for (; inFlight != 0; --inFlight, first = (first + 1) % buffer->size())
+            buffer->wait(first);
+    }
+
+    bool has_next()
+    {
+        dispatch();
+        return inFlight != 0;
+    }
+
+    result_type next()
+    {
+        const bool found = has_next();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        auto& current = front();
+        auto& slot = current.outputs[current.position];
+        output result = std::move(slot.get());
+        slot.reset();
+
+        advance(current);
+        return result;
+    }
+
+    void skip()
+    {
+        const bool found = has_next();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        auto& current = front();
+        current.outputs[current.position].reset();
+        advance(current);
+    }
+
+    size_t elements_count() const
+    {
+        const auto count = iterator.elements_count();
+        if (count == unknown_count) return unknown_count;
+
+        size_t buffered = 0;
+        for (size_t i = 0; i < inFlight; ++i)
+        {
+            const auto& pending = (*buffer)[(first + i) % buffer->size()];
+            buffered += pending.inputs.size() - pending.position;
+        }
+
+        return count + buffered;
+    }
+
+private:
+
+    using batch_t = typename buffer_t::batch_t;
+
+    // NOTE: fills the free batches of the ring from the upstream and passes them to the executor
+    void dispatch()
+    {
+        while (inFlight != buffer->size() && iterator.has_next())
+        {
+            const auto index = (first + inFlight) % buffer->size();
+            auto& pending = (*buffer)[index];
+
+            pending.inputs.clear();
+            pending.position = 0;
+            pending.error = nullptr;
+            pending.done = false;
+
+            while (pending.inputs.size() != parameters.batchSize && iterator.has_next())
+                pending.inputs.emplace_back(iterator.next());
+
+            // NOTE: counted after the executor accepts the batch, a batch which failed to start is never waited for
+            parameters.executor([state = buffer, index, &function = parameters.function]() noexcept
+            {
+                state->process(index, function);
+            });
+            ++inFlight;
+        }
+    }
+
+    batch_t& front()
+    {
+        auto& current = buffer->wait(first);
+        if (current.error) std::rethrow_exception(current.error);
+
+        return current;
+    }
+
+    void advance(batch_t& current) noexcept
+    {
+        if (++current.position != current.inputs.size()) return;
+
+        first = (first + 1) % buffer->size();
+        --inFlight;
+    }
+
+    std::shared_ptr<buffer_t> buffer;
+    Parameters parameters;
+    size_t first;
+    size_t inFlight;
+};
+
+} // exstream namespace
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "transform_iterator.hpp"
+#include "meta_info.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cassert>
+#include <utility>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+namespace scan {
+
+// NOTE: the state is replaced by the result of the function called with the moved state and the element
+template <typename State, typename Function>
+struct fold_parameters final
+{
+    using state_type = State;
+
+    template <typename T>
+    void update(State& state, T&& value) const
+    {
+        state = function(std::move(state), std::forward<T>(value));
+    }
+
+    State initial;
+    const Function& function;
+};
+
+// NOTE: the element is added to the aggregator in place, so the aggregators with buffers aren't moved per element
+template <typename Aggregator>
+struct aggregate_parameters final
+{
+    using state_type = Aggregator;
+
+    template <typename T>
+    void update(Aggregator& state, T&& value) const
+    {
+        state.add(std::forward<T>(value));
+    }
+
+    Aggregator initial;
+};
+
+}} // detail::scan namespace
+
+template <typename State, typename Function>
+struct is_transformation_parameter<detail::scan::fold_parameters<State, Function>> : std::true_type {};
+
+template <typename Aggregator>
+struct is_transformation_parameter<detail::scan::aggregate_parameters<Aggregator>> : std::true_type {};
+
+// NOTE: emits the state updated by every element, the state is returned by a reference
+//       which is valid until the next element is requested, so copy it to keep it
+template <typename Iterator,
+          typename Parameters,
+          typename Meta>
+class scan_iterator final : public transform_iterator<Iterator>
+{
+    using state_type = typename Parameters::state_type;
+public:
+
+    using value_type = state_type;
+    using result_type = const state_type&;
+    using meta = meta_info<false, false, Order::Unknown>;
+
+    template <typename Allocator>
+    explicit scan_iterator(const Iterator& iterator, const Parameters& parameters, const Allocator&)
+        : transform_iterator(iterator),
+          parameters(parameters),
+          state(parameters.initial)
+    {
+    }
+
+    template <typename Allocator>
+    explicit scan_iterator(Iterator&& iterator, const Parameters& parameters, const Allocator&)
+        : transform_iterator(std::move(iterator)),
+          parameters(parameters),
+          state(parameters.initial)
+    {
+    }
+
+    scan_iterator(const scan_iterator&) = delete;
+    scan_iterator(scan_iterator&&) = default;
+
+    scan_iterator& operator= (const scan_iterator&) = delete;
+    scan_iterator& operator= (scan_iterator&&) = delete;
+
+    bool has_next() noexcept(noexcept(std::declval<Iterator&>().has_next()))
+    {
+        return iterator.has_next();
+    }
+
+    result_type next()
+    {
+        assert(has_next() && "Iterator is out of range");
+        parameters.update(state, iterator.next());
+        return state;
+    }
+
+    // NOTE: the skipped elements still update the state
+    void skip()
+    {
+        assert(has_next() && "Iterator is out of range");
+        parameters.update(state, iterator.next());
+    }
+
+    size_t elements_count() const noexcept(noexcept(std::declval<Iterator&>().elements_count()))
+    {
+        return iterator.elements_count();
+    }
+
+private:
+
+    const Parameters& parameters;
+    state_type state;
+};
+
+} // exstream namespace
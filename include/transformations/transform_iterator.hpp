@@ -8,6 +8,14 @@ EXSTREAM_RESTORE_ALL_WARNINGS
 
 namespace exstream {
 
+// NOTE: parameters of the transformations (e.g. window sizes) are created by the transformation methods,
+//       so transformations keep a copy of them instead of a reference
+template <typename Function>
+struct is_transformation_parameter : std::false_type {};
+
+template <typename Function>
+constexpr bool is_transformation_parameter_v = is_transformation_parameter<Function>::value;
+
 template <typename Iterator>
 class transform_iterator
 {
@@ -57,7 +57,8 @@ class transformation : public base_transformation<T, Source, TransformIterator,
     static_assert(std::is_constructible_v<TransformIterator, source_iterator, const Function&, const Allocator&>, "Invalid TransformIterator");
 public:
 
-    explicit transformation(const Source& source, const Function& function, const Allocator& alloc) noexcept
+    explicit transformation(const Source& source, const Function& function, const Allocator& alloc) noexcept(!is_transformation_parameter_v<Function> ||
+                                                                                                             std::is_nothrow_copy_constructible_v<Function>)
         : base_transformation(source, alloc),
           function(function)
     {
@@ -76,7 +77,7 @@ public:
 
 private:
 
-    const Function& function;
+    std::conditional_t<is_transformation_parameter_v<Function>, const Function, const Function&> function;
 };
 
 template <typename T,
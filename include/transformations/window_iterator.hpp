@@ -0,0 +1,271 @@
+#pragma once
+
+#include "transform_iterator.hpp"
+#include "option.hpp"
+#include "meta_info.hpp"
+#include "detail/result_traits.hpp"
+#include "detail/type_traits.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+namespace exstream {
+namespace detail {
+namespace window {
+
+struct parameters final
+{
+    size_t size;
+    size_t step;
+    bool partial; // emit the last window even if the source ends before it is full
+};
+
+}} // detail::window namespace
+
+template <>
+struct is_transformation_parameter<detail::window::parameters> : std::true_type {};
+
+// NOTE: a view over the window elements kept in the ring buffer of the window iterator,
+//       it is valid until the next window is requested, so map it to something owning before collecting
+template <typename Storage>
+class window_view final
+{
+    using slot = option<Storage>;
+public:
+
+    using value_type = remove_cvr_t<decltype(std::declval<const Storage&>().get_ref())>;
+
+    class const_iterator final
+    {
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename window_view::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator(const window_view& view, const size_t index) noexcept
+            : view(&view),
+              index(index)
+        {
+        }
+
+        reference operator* () const noexcept
+        {
+            return (*view)[index];
+        }
+
+        pointer operator-> () const noexcept
+        {
+            return std::addressof((*view)[index]);
+        }
+
+        const_iterator& operator++ () noexcept
+        {
+            ++index;
+            return *this;
+        }
+
+        const_iterator operator++ (int) noexcept
+        {
+            const auto copy = *this;
+            ++index;
+            return copy;
+        }
+
+        bool operator== (const const_iterator& that) const noexcept
+        {
+            return index == that.index;
+        }
+
+        bool operator!= (const const_iterator& that) const noexcept
+        {
+            return index != that.index;
+        }
+
+    private:
+
+        const window_view* view;
+        size_t index;
+    };
+
+    using iterator = const_iterator;
+
+    window_view(const slot* slots, const size_t capacity, const size_t first, const size_t count) noexcept
+        : slots(slots),
+          capacity(capacity),
+          first(first),
+          count(count)
+    {
+    }
+
+    size_t size() const noexcept
+    {
+        return count;
+    }
+
+    bool empty() const noexcept
+    {
+        return count == 0;
+    }
+
+    const value_type& operator[] (const size_t index) const noexcept
+    {
+        assert(index < count && "Index is out of range");
+        const auto position = first + index;
+        return slots[(position < capacity) ? position : position - capacity].get().get_ref();
+    }
+
+    const value_type& front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    const value_type& back() const noexcept
+    {
+        return (*this)[count - 1];
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(*this, 0);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(*this, count);
+    }
+
+private:
+
+    const slot* slots;
+    size_t capacity;
+    size_t first;
+    size_t count;
+};
+
+// NOTE: windows of size elements starting every step elements, the elements are stored once in a ring buffer
+//       allocated at the construction, so the overlapping elements of the sliding windows aren't copied
+template <typename Iterator,
+          typename Parameters,
+          typename Meta,
+          typename Allocator>
+class window_iterator final : public transform_iterator<Iterator>
+{
+    using storage = typename result_traits<typename Iterator::result_type>::storage;
+    using slot = option<storage>;
+    using slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<slot>;
+public:
+
+    using value_type = window_view<storage>;
+    using result_type = window_view<storage>;
+    using meta = meta_info<false, false, Order::Unknown>;
+
+    explicit window_iterator(const Iterator& iterator, const Parameters& parameters, const Allocator& alloc)
+        : transform_iterator(iterator),
+          slots(parameters.size, slot_allocator(alloc)),
+          parameters(parameters),
+          first(0),
+          filled(0),
+          started(false),
+          ready(false)
+    {
+    }
+
+    explicit window_iterator(Iterator&& iterator, const Parameters& parameters, const Allocator& alloc)
+        : transform_iterator(std::move(iterator)),
+          slots(parameters.size, slot_allocator(alloc)),
+          parameters(parameters),
+          first(0),
+          filled(0),
+          started(false),
+          ready(false)
+    {
+    }
+
+    window_iterator(const window_iterator&) = delete;
+    window_iterator(window_iterator&&) = default;
+
+    window_iterator& operator= (const window_iterator&) = delete;
+    window_iterator& operator= (window_iterator&&) = delete;
+
+    bool has_next()
+    {
+        return fetch();
+    }
+
+    result_type next()
+    {
+        const bool found = fetch();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        ready = false;
+        return result_type(slots.data(), slots.size(), first, filled);
+    }
+
+    void skip()
+    {
+        const bool found = fetch();
+        EXSTREAM_UNUSED(found);
+        assert(found && "Iterator is out of range");
+
+        ready = false;
+    }
+
+    size_t elements_count() const
+    {
+        const auto count = iterator.elements_count();
+        if (count == unknown_count) return unknown_count;
+
+        const auto current = ready ? size_t(1) : size_t(0);
+        if (parameters.partial) return current + (count + parameters.step - 1) / parameters.step;
+        if (started) return current + count / parameters.step;
+
+        return (count < parameters.size) ? 0 : (count - parameters.size) / parameters.step + 1;
+    }
+
+private:
+
+    // NOTE: drops the elements of the previous window which don't belong to the next one and appends the new ones
+    bool fetch()
+    {
+        if (ready) return true;
+
+        if (started)
+        {
+            const auto dropped = std::min(parameters.step, filled);
+            first = (first + dropped) % parameters.size;
+            filled -= dropped;
+
+            for (auto gap = parameters.step - dropped; gap != 0 && iterator.has_next(); --gap)
+                iterator.skip();
+        }
+
+        const auto previous = filled;
+        while (filled != parameters.size && iterator.has_next())
+        {
+            slots[(first + filled) % parameters.size].emplace(iterator.next());
+            ++filled;
+        }
+
+        started = true;
+        ready = (filled == parameters.size) || (parameters.partial && filled != previous);
+        return ready;
+    }
+
+    std::vector<slot, slot_allocator> slots;
+    Parameters parameters;
+    size_t first;
+    size_t filled;
+    bool started;
+    bool ready;
+};
+
+} // exstream namespace
@@ -5,11 +5,22 @@
 #include "detail/result_traits.hpp"
 #include "detail/constexpr_if.hpp"
 #include "error_transformation.hpp"
+#include "instrumentation.hpp"
 
 #include "map_iterator.hpp"
 #include "flat_map_iterator.hpp"
+#include "flat_map_into_iterator.hpp"
 #include "filter_iterator.hpp"
 #include "distinct_iterator.hpp"
+#include "flatten_iterator.hpp"
+#include "filter_map_iterator.hpp"
+#include "alternative_iterator.hpp"
+#include "enumerate_iterator.hpp"
+#include "window_iterator.hpp"
+#include "async_iterator.hpp"
+#include "par_map_iterator.hpp"
+#include "scan_iterator.hpp"
+#include "bloom_distinct_iterator.hpp"
 
 namespace exstream {
 
@@ -48,6 +59,32 @@ public:
             })(nothing);
     }
 
+    // NOTE: maps batches of elements on the executor and keeps the order of the results, see par_map_iterator
+    template <typename Function, typename Executor>
+    auto par_map(const Function& function,
+                 const Executor& executor,
+                 const size_t batchSize = detail::par_map::default_batch_size,
+                 const size_t window = detail::par_map::default_window()) const noexcept
+    {
+        using arg_type = typename Self::iterator_type::result_type;
+
+        return constexpr_if<is_invokable_v<const Function&, arg_type>>()
+            .then([&](auto) noexcept
+            {
+                using allocator = typename Self::allocator;
+
+                assert(batchSize != 0 && window != 0 && "Batch size and window should be positive");
+                return make_transformation<partial_apply4<par_map_iterator, allocator>::bind_4>(
+                    detail::par_map::parameters<Function, Executor>{ function, executor, batchSize, window }
+                );
+            })
+            .else_([](auto) noexcept
+            {
+                static_assert(false, "Illegal function signature");
+                return error_transformation();
+            })(nothing);
+    }
+
     template <typename Function>
     auto flat_map(const Function& function) const noexcept
     {
@@ -56,7 +93,7 @@ public:
         return constexpr_if<is_invokable_v<const Function&, arg_type>>()
             .then([&](auto) noexcept
             {
-                using function_result = std::result_of_t<const Function&(arg_type)>;
+                using function_result = result_of_t<const Function&(arg_type)>;
 
                 return constexpr_if<is_iterable<std::decay_t<function_result>>::value>()
                     .then([&](auto) noexcept
@@ -80,6 +117,27 @@ public:
             })(nothing);
     }
 
+    template <typename U, typename Function>
+    auto flat_map_into(const Function& function) const noexcept
+    {
+        using arg_type = typename Self::iterator_type::result_type;
+        using allocator = typename Self::allocator;
+        using emitter_type = detail::flat_map::emitter<U>;
+
+        return constexpr_if<is_invokable_v<const Function&, arg_type, emitter_type&>>()
+            .then([&](auto) noexcept
+            {
+                return make_transformation<
+                    partial_apply4<partial_apply5<flat_map_into_iterator, U>::template bind_5, allocator>::template bind_4
+                >(function);
+            })
+            .else_([](auto) noexcept
+            {
+                static_assert(false, "Illegal function signature");
+                return error_transformation();
+            })(nothing);
+    }
+
     template <typename Function>
     auto filter(const Function& function) const noexcept
     {
@@ -95,6 +153,146 @@ public:
             })(nothing);
     }
 
+    template <typename Function>
+    auto filter_map(const Function& function) const noexcept
+    {
+        using arg_type = typename Self::iterator_type::result_type;
+
+        return constexpr_if<is_invokable_v<const Function&, arg_type>>()
+            .then([&](auto) noexcept
+            {
+                using function_result = result_of_t<const Function&(arg_type)>;
+
+                return constexpr_if<is_option_v<std::decay_t<function_result>>>()
+                    .then([&](auto) noexcept
+                    {
+                        return make_transformation<filter_map_iterator>(function);
+                    })
+                    .else_([](auto) noexcept
+                    {
+                        static_assert(false, "Function return type needs to be an option");
+                        return error_transformation();
+                    })(nothing);
+            })
+            .else_([](auto) noexcept
+            {
+                static_assert(false, "Illegal function signature");
+                return error_transformation();
+            })(nothing);
+    }
+
+    auto flatten() const noexcept
+    {
+        return constexpr_if<is_option_v<std::decay_t<typename Self::iterator_type::result_type>>>()
+            .then([&](auto) noexcept
+            {
+                return make_transformation<flatten_iterator>();
+            })
+            .else_([](auto) noexcept
+            {
+                static_assert(false, "Flatten requires a stream of options");
+                return error_transformation();
+            })(nothing);
+    }
+
+    template <typename U>
+    auto collect_variants() const noexcept
+    {
+        using variant_type = std::decay_t<typename Self::iterator_type::result_type>;
+
+        return constexpr_if<is_variant_v<variant_type>>()
+            .then([&](auto) noexcept
+            {
+                return constexpr_if<detail::variant_traits<variant_type>::template has_alternative<U>>()
+                    .then([&](auto) noexcept
+                    {
+                        return make_transformation<partial_apply3<alternative_iterator, U>::template bind_3>();
+                    })
+                    .else_([](auto) noexcept
+                    {
+                        static_assert(false, "Type isn't an alternative of the variant");
+                        return error_transformation();
+                    })(nothing);
+            })
+            .else_([](auto) noexcept
+            {
+                static_assert(false, "Collect variants requires a stream of variants");
+                return error_transformation();
+            })(nothing);
+    }
+
+    auto enumerate() const noexcept
+    {
+        return make_transformation<enumerate_iterator>();
+    }
+
+    // NOTE: consecutive windows of size elements, the last one may be shorter
+    auto chunked(const size_t size) const noexcept
+    {
+        assert(size != 0 && "Chunk size should be positive");
+        return make_window(detail::window::parameters{ size, size, true });
+    }
+
+    // NOTE: full windows of size elements starting every step elements
+    auto sliding(const size_t size, const size_t step = 1) const noexcept
+    {
+        assert(size != 0 && step != 0 && "Window size and step should be positive");
+        return make_window(detail::window::parameters{ size, step, false });
+    }
+
+    // NOTE: runs the upstream stages on the executor, see async_iterator
+    template <typename Executor>
+    auto async(const Executor& executor, const size_t capacity = detail::async::default_capacity) const noexcept
+    {
+        using allocator = typename Self::allocator;
+
+        assert(capacity != 0 && "Queue capacity should be positive");
+        return make_transformation<partial_apply4<async_iterator, allocator>::bind_4>(
+            detail::async::parameters<Executor>{ executor, capacity }
+        );
+    }
+
+    // NOTE: emits the state after every element, the function takes the moved state and an element and returns the new state
+    template <typename State, typename Function>
+    auto scan(State&& initial, const Function& function) const
+    {
+        using arg_type = typename Self::iterator_type::result_type;
+        using state_type = std::decay_t<State>;
+
+        return constexpr_if<is_invokable_v<const Function&, state_type&&, arg_type>>()
+            .then([&](auto)
+            {
+                return make_transformation<scan_iterator>(
+                    detail::scan::fold_parameters<state_type, Function>{ std::forward<State>(initial), function }
+                );
+            })
+            .else_([](auto) noexcept
+            {
+                static_assert(false, "Illegal function signature");
+                return error_transformation();
+            })(nothing);
+    }
+
+    // NOTE: emits the aggregator after every added element, see aggregators.hpp
+    template <typename Aggregator>
+    auto running(Aggregator&& aggregator) const
+    {
+        using aggregator_type = std::decay_t<Aggregator>;
+
+        return constexpr_if<is_aggregator_v<aggregator_type, T>>()
+            .then([&](auto)
+            {
+                return make_transformation<scan_iterator>(
+                    detail::scan::aggregate_parameters<aggregator_type>{ std::forward<Aggregator>(aggregator) }
+                );
+            })
+            .else_([](auto) noexcept
+            {
+                static_assert(false, "Invalid aggregator");
+                return error_transformation();
+            })(nothing);
+    }
+
     auto distinct() const noexcept
     {
         using allocator = typename Self::allocator;
@@ -102,6 +300,19 @@ public:
         return make_transformation<partial_apply3<distinct_iterator, allocator>::bind_3>();
     }
 
+    // NOTE: a distinct in the fixed memory, it drops a new element with the false positive rate,
+    //       the filter is sized by the upstream count if it's known, up to the expected count
+    auto bloom_distinct(const double fpRate = bloom_filter<>::default_fp_rate,
+                        const size_t expectedCount = detail::bloom::default_expected_count) const noexcept
+    {
+        using allocator = typename Self::allocator;
+
+        assert(fpRate > 0.0 && fpRate < 1.0 && "False positive rate should be in (0, 1)");
+        return make_transformation<partial_apply4<bloom_distinct_iterator, allocator>::bind_4>(
+            detail::bloom::parameters{ fpRate, expectedCount }
+        );
+    }
+
 private:
 
     const Self& self() const noexcept
@@ -109,14 +320,24 @@ private:
         return static_cast<const Self&>(*this);
     }
 
+    auto make_window(const detail::window::parameters& parameters) const noexcept
+    {
+        using allocator = typename Self::allocator;
+
+        return make_transformation<partial_apply4<window_iterator, allocator>::bind_4>(parameters);
+    }
+
     template <template <typename, typename, typename> class TransformIterator, typename Function>
-    auto make_transformation(const Function& function) const noexcept
+    auto make_transformation(const Function& function) const noexcept(!is_transformation_parameter_v<Function> ||
+                                                                      std::is_nothrow_copy_constructible_v<Function>)
     {
         using self_iterator_type = typename Self::iterator_type;
         using allocator = typename Self::allocator;
         using meta = typename Self::meta;
 
-        using iterator_type = TransformIterator<self_iterator_type, Function, meta>;
+        using iterator_type = detail::instrumentation::stage_t<
+            TransformIterator<detail::instrumentation::upstream_t<self_iterator_type>, Function, meta>
+        >;
         using new_meta = typename iterator_type::meta;
         using value_type = typename iterator_type::value_type;
 
@@ -130,7 +351,9 @@ private:
         using allocator = typename Self::allocator;
         using meta = typename Self::meta;
 
-        using iterator_type = TransformIterator<self_iterator_type, meta>;
+        using iterator_type = detail::instrumentation::stage_t<
+            TransformIterator<detail::instrumentation::upstream_t<self_iterator_type>, meta>
+        >;
         using new_meta = typename iterator_type::meta;
         using value_type = typename iterator_type::value_type;
 
@@ -1,198 +1,566 @@
 #pragma once
 
 #include "option.hpp"
+#include "niche_traits.hpp"
 #include "detail/type_list.hpp"
 
 EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cstdint>
 #include <exception>
+#include <initializer_list>
+#include <limits>
+#include <tuple>
 EXSTREAM_RESTORE_ALL_WARNINGS
 
 namespace exstream {
 
 constexpr size_t variant_npos = size_t(-1);
 
+template <typename... Ts>
+class variant;
+
+template <typename T>
+struct is_variant : public std::false_type {};
+
+template <typename... Ts>
+struct is_variant<variant<Ts...>> : public std::true_type {};
+
+template <typename T>
+constexpr bool is_variant_v = is_variant<T>::value;
+
 class bad_variant_access : public std::exception {};
 
 namespace detail {
 
+// NOTE: every operation builds a table of per-alternative functions indexed by the variant index
 template <typename... Ts>
-struct variant_helper;
-
-template<typename T, typename... Ts>
-struct variant_helper<T, Ts...> final
+struct variant_helper final
 {
+    // NOTE: small variants compare the index with every alternative, compilers inline such chains
+    static constexpr size_t chain_dispatch_size = 8;
+
+    using is_nothrow_destructible       = std::conjunction<std::is_nothrow_destructible<Ts>...>;
+    using is_nothrow_copy_constructible = std::conjunction<std::is_nothrow_copy_constructible<Ts>...>;
+    using is_nothrow_move_constructible = std::conjunction<std::is_nothrow_move_constructible<Ts>...>;
+    using is_nothrow_copy_assignable    = std::conjunction<std::is_nothrow_copy_assignable<Ts>...>;
+    using is_nothrow_move_assignable    = std::conjunction<std::is_nothrow_move_assignable<Ts>...>;
+    using is_nothrow_swappable          = std::conjunction<std::is_nothrow_swappable<std::add_lvalue_reference_t<Ts>>...>;
+
     EXSTREAM_FORCEINLINE
-    static void destroy(const size_t index, void* ptr) noexcept(std::is_nothrow_destructible_v<T> && std::conjunction_v<std::is_nothrow_destructible<Ts>...>)
+    static void destroy(const size_t index, void* ptr) noexcept(is_nothrow_destructible::value)
     {
-        if (index == sizeof...(Ts))
-        {
-            static_cast<T*>(ptr)->~T();
-        }
-        else
-        {
-            variant_helper<Ts...>::destroy(index, ptr);
-        }
+        using function_t = void (*)(void*);
+        static constexpr function_t table[] = { &destroy_alternative<Ts>... };
+        dispatch(table, index, ptr);
     }
 
     EXSTREAM_FORCEINLINE
-    static void copy(const size_t index, const void* from, void* to) noexcept(std::is_nothrow_copy_constructible_v<T> && std::conjunction_v<std::is_nothrow_copy_constructible<Ts>...>)
+    static void copy(const size_t index, const void* from, void* to) noexcept(is_nothrow_copy_constructible::value)
     {
-        if (index == sizeof...(Ts))
-        {
-            new (static_cast<T*>(to)) T(*static_cast<const T*>(from));
-        }
-        else
-        {
-            variant_helper<Ts...>::copy(index, from, to);
-        }
+        using function_t = void (*)(const void*, void*);
+        static constexpr function_t table[] = { &copy_alternative<Ts>... };
+        dispatch(table, index, from, to);
     }
 
     EXSTREAM_FORCEINLINE
-    static void move(const size_t index, void* from, void* to) noexcept(std::is_nothrow_move_constructible_v<T> && std::conjunction_v<std::is_nothrow_move_constructible<Ts>...>)
+    static void move(const size_t index, void* from, void* to) noexcept(is_nothrow_move_constructible::value)
     {
-        if (index == sizeof...(Ts))
-        {
-            new (static_cast<T*>(to)) T(std::move(*static_cast<T*>(from)));
-        }
-        else
-        {
-            variant_helper<Ts...>::move(index, from, to);
-        }
+        using function_t = void (*)(void*, void*);
+        static constexpr function_t table[] = { &move_alternative<Ts>... };
+        dispatch(table, index, from, to);
     }
 
     EXSTREAM_FORCEINLINE
-    static void assign(const size_t index, const void* from, void* to) noexcept
+    static void assign(const size_t index, const void* from, void* to) noexcept(is_nothrow_copy_assignable::value)
     {
-        if (index == sizeof...(Ts))
-        {
-            *(static_cast<T*>(to)) = *(static_cast<const T*>(from));
-        }
-        else
-        {
-            variant_helper<Ts...>::assign(index, from, to);
-        }
+        using function_t = void (*)(const void*, void*);
+        static constexpr function_t table[] = { &assign_alternative<Ts>... };
+        dispatch(table, index, from, to);
     }
 
     EXSTREAM_FORCEINLINE
-    static void move_assign(const size_t index, void* from, void* to) noexcept
+    static void move_assign(const size_t index, void* from, void* to) noexcept(is_nothrow_move_assignable::value)
     {
-        if (index == sizeof...(Ts))
-        {
-            *(static_cast<T*>(to)) = std::move(*(static_cast<T*>(from)));
-        }
-        else
-        {
-            variant_helper<Ts...>::move_assign(index, from, to);
-        }
+        using function_t = void (*)(void*, void*);
+        static constexpr function_t table[] = { &move_assign_alternative<Ts>... };
+        dispatch(table, index, from, to);
     }
 
     EXSTREAM_FORCEINLINE
-    static void swap(const size_t index, void* lhs, void* rhs) noexcept(std::is_nothrow_swappable_v<T>)
+    static void swap(const size_t index, void* lhs, void* rhs) noexcept(is_nothrow_swappable::value)
     {
-        if (index == sizeof...(Ts))
-        {
-            using std::swap;
-            swap(*static_cast<T*>(lhs), *static_cast<T*>(rhs));
-        }
-        else
-        {
-            variant_helper<Ts...>::swap(index, lhs, rhs);
-        }
+        using function_t = void (*)(void*, void*);
+        static constexpr function_t table[] = { &swap_alternative<Ts>... };
+        dispatch(table, index, lhs, rhs);
     }
 
     EXSTREAM_FORCEINLINE
     static size_t hash(const size_t index, const void* ptr) noexcept
     {
-        if (index == sizeof...(Ts))
-            return std::hash<T>()(*static_cast<const T*>(ptr));
-
-        return variant_helper<Ts...>::hash(index, ptr);
+        using function_t = size_t (*)(const void*);
+        static constexpr function_t table[] = { &hash_alternative<Ts>... };
+        return dispatch(table, index, ptr);
     }
 
     template <typename Result, typename Function>
     EXSTREAM_FORCEINLINE static Result invoke(const size_t index, void* ptr, Function&& function)
-        noexcept(noexcept(std::declval<Function>()(std::declval<T&>())))
     {
-        if (index == sizeof...(Ts))
-            return function(*static_cast<T*>(ptr));
-
-        return variant_helper<Ts...>::template invoke<Result>(index, ptr, std::forward<Function>(function));
+        using function_t = Result (*)(void*, Function&&);
+        static constexpr function_t table[] = { &invoke_alternative<Result, Function, Ts&, void*>... };
+        return dispatch(table, index, ptr, std::forward<Function>(function));
     }
 
     template <typename Result, typename Function>
     EXSTREAM_FORCEINLINE static Result invoke(const size_t index, const void* ptr, Function&& function)
-        noexcept(noexcept(std::declval<Function>()(std::declval<const T&>())))
     {
-        if (index == sizeof...(Ts))
-            return function(*static_cast<const T*>(ptr));
-
-        return variant_helper<Ts...>::template invoke<Result>(index, ptr, std::forward<Function>(function));
+        using function_t = Result (*)(const void*, Function&&);
+        static constexpr function_t table[] = { &invoke_alternative<Result, Function, const Ts&, const void*>... };
+        return dispatch(table, index, ptr, std::forward<Function>(function));
     }
 
     template <typename Result, typename Function>
     EXSTREAM_FORCEINLINE static Result invoke_on_rvalue(const size_t index, void* ptr, Function&& function)
-        noexcept(noexcept(std::declval<Function>()(std::declval<T&&>())))
     {
-        if (index == sizeof...(Ts))
-            return function(std::move(*static_cast<T*>(ptr)));
+        using function_t = Result (*)(void*, Function&&);
+        static constexpr function_t table[] = { &invoke_alternative<Result, Function, Ts&&, void*>... };
+        return dispatch(table, index, ptr, std::forward<Function>(function));
+    }
+
+private:
+
+    template <typename Function, size_t Size, typename... Args>
+    EXSTREAM_FORCEINLINE static decltype(auto) dispatch(const Function (&table)[Size], const size_t index, Args&&... args)
+    {
+        return dispatch_chain<0>(table, index, std::bool_constant<(Size == 1)>(), std::bool_constant<(Size <= chain_dispatch_size)>(),
+                                 std::forward<Args>(args)...);
+    }
+
+    template <size_t Index, typename Function, size_t Size, typename IsLast, typename... Args>
+    EXSTREAM_FORCEINLINE static decltype(auto) dispatch_chain(const Function (&table)[Size], const size_t index, IsLast, std::false_type /* use chain */,
+                                                              Args&&... args)
+    {
+        return table[index](std::forward<Args>(args)...);
+    }
+
+    template <size_t Index, typename Function, size_t Size, typename... Args>
+    EXSTREAM_FORCEINLINE static decltype(auto) dispatch_chain(const Function (&table)[Size], const size_t, std::true_type /* last */, std::true_type /* use chain */,
+                                                              Args&&... args)
+    {
+        return table[Index](std::forward<Args>(args)...);
+    }
+
+    template <size_t Index, typename Function, size_t Size, typename... Args>
+    EXSTREAM_FORCEINLINE static decltype(auto) dispatch_chain(const Function (&table)[Size], const size_t index, std::false_type /* last */, std::true_type /* use chain */,
+                                                              Args&&... args)
+    {
+        if (index == Index)
+            return table[Index](std::forward<Args>(args)...);
+
+        return dispatch_chain<Index + 1>(table, index, std::bool_constant<(Index + 2 == Size)>(), std::true_type(), std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    static void destroy_alternative(void* ptr) noexcept(std::is_nothrow_destructible_v<T>)
+    {
+        static_cast<T*>(ptr)->~T();
+    }
+
+    template <typename T>
+    static void copy_alternative(const void* from, void* to) noexcept(std::is_nothrow_copy_constructible_v<T>)
+    {
+        new (static_cast<T*>(to)) T(*static_cast<const T*>(from));
+    }
+
+    template <typename T>
+    static void move_alternative(void* from, void* to) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        new (static_cast<T*>(to)) T(std::move(*static_cast<T*>(from)));
+    }
+
+    template <typename T>
+    static void assign_alternative(const void* from, void* to) noexcept(std::is_nothrow_copy_assignable_v<T>)
+    {
+        *(static_cast<T*>(to)) = *(static_cast<const T*>(from));
+    }
 
-        return variant_helper<Ts...>::template invoke_on_rvalue<Result>(index, ptr, std::forward<Function>(function));
+    template <typename T>
+    static void move_assign_alternative(void* from, void* to) noexcept(std::is_nothrow_move_assignable_v<T>)
+    {
+        *(static_cast<T*>(to)) = std::move(*(static_cast<T*>(from)));
+    }
+
+    template <typename T>
+    static void swap_alternative(void* lhs, void* rhs) noexcept(std::is_nothrow_swappable_v<T>)
+    {
+        using std::swap;
+        swap(*static_cast<T*>(lhs), *static_cast<T*>(rhs));
+    }
+
+    template <typename T>
+    static size_t hash_alternative(const void* ptr) noexcept
+    {
+        return std::hash<T>()(*static_cast<const T*>(ptr));
+    }
+
+    // NOTE: Reference is T&, const T& or T&& depending on the matched variant value category
+    template <typename Result, typename Function, typename Reference, typename Pointer>
+    static Result invoke_alternative(Pointer ptr, Function&& function)
+        noexcept(noexcept(std::declval<Function>()(std::declval<Reference>())))
+    {
+        using value_type = std::remove_reference_t<Reference>;
+        return std::forward<Function>(function)(static_cast<Reference>(*static_cast<value_type*>(ptr)));
     }
 };
 
-template<>
-struct variant_helper<> final
+template <size_t Count>
+using variant_index_t = std::conditional_t<(Count < size_t(UINT8_MAX)),  uint8_t,
+                        std::conditional_t<(Count < size_t(UINT16_MAX)), uint16_t,
+                                                                          uint32_t>>;
+
+// NOTE: keeps the index in the smallest integer type which fits all of the alternatives and the valueless state
+template <typename Storage, typename... Ts>
+class variant_storage final
 {
-    static void destroy(const size_t, void*) noexcept
+    using index_type = variant_index_t<sizeof...(Ts)>;
+
+    static constexpr auto npos = std::numeric_limits<index_type>::max();
+
+public:
+
+    variant_storage() noexcept
+        : storage(),
+          index_(npos)
     {
     }
 
-    static void copy(const size_t, const void*, void*) noexcept
+    void* pointer() noexcept
     {
+        return reinterpret_cast<void*>(std::addressof(storage));
     }
 
-    static void move(const size_t, const void*, void*) noexcept
+    const void* pointer() const noexcept
     {
+        return reinterpret_cast<const void*>(std::addressof(storage));
     }
 
-    static void assign(const size_t, const void*, void*) noexcept
+    size_t index() const noexcept
     {
+        return (index_ == npos) ? variant_npos : size_t(index_);
     }
 
-    static void move_assign(const size_t, void*, void*) noexcept
+    void set_index(const size_t index) noexcept
     {
+        index_ = (index == variant_npos) ? npos : index_type(index);
     }
 
-    static void swap(const size_t, void*, void*) noexcept
+private:
+
+    Storage storage;
+    index_type index_;
+};
+
+// NOTE: keeps the index in a niche of the only non-empty alternative, so the variant is as large as that alternative.
+//       Niche NicheIndex marks the valueless state, the other niches are indices of the empty alternatives.
+template <size_t NicheIndex, typename Storage, typename... Ts>
+class niche_variant_storage final
+{
+    using traits = niche_traits<std::tuple_element_t<NicheIndex, std::tuple<Ts...>>>;
+
+public:
+
+    niche_variant_storage() noexcept
+        : storage()
     {
     }
 
-    static size_t hash(const size_t, const void*) noexcept
+    void* pointer() noexcept
     {
-        return size_t(0);
+        return reinterpret_cast<void*>(std::addressof(storage));
     }
 
-    // NOTE: invoke* functions never executed and used to stop recursion only
+    const void* pointer() const noexcept
+    {
+        return reinterpret_cast<const void*>(std::addressof(storage));
+    }
 
-    template <typename Result, typename Function>
-    [[noreturn]] static Result invoke(const size_t, void*, Function&&) noexcept
+    size_t index() const noexcept
     {
-        std::terminate(); // dummy terminate
+        const auto niche = traits::load(pointer());
+
+        if (niche == niche_npos)  return NicheIndex;
+        if (niche == NicheIndex)  return variant_npos;
+        return niche;
     }
 
-    template <typename Result, typename Function>
-    [[noreturn]] static Result invoke(const size_t, const void*, Function&&) noexcept
+    // NOTE: should be called after construction of the alternative, which overwrites the niche
+    void set_index(const size_t index) noexcept
     {
-        std::terminate(); // dummy terminate
+        if (index == NicheIndex) return;
+        traits::store(pointer(), (index == variant_npos) ? NicheIndex : index);
     }
 
-    template <typename Result, typename Function>
-    [[noreturn]] static Result invoke_on_rvalue(const size_t, void*, Function&&) noexcept
+private:
+
+    Storage storage;
+};
+
+template <typename... Ts>
+constexpr size_t niche_alternative_index() noexcept
+{
+    constexpr size_t niches[] = { niche_traits<Ts>::count... };
+    constexpr bool empties[] = { std::is_empty_v<Ts>... };
+
+    size_t result = type_list_npos;
+    for (size_t i = 0; i < sizeof...(Ts); ++i)
+    {
+        if (empties[i]) continue;
+        if (result != type_list_npos || niches[i] < sizeof...(Ts)) return type_list_npos;
+        result = i;
+    }
+
+    return result;
+}
+
+template <typename Storage, size_t NicheIndex, typename... Ts>
+struct variant_storage_selector
+{
+    using type = niche_variant_storage<NicheIndex, Storage, Ts...>;
+};
+
+template <typename Storage, typename... Ts>
+struct variant_storage_selector<Storage, type_list_npos, Ts...>
+{
+    using type = variant_storage<Storage, Ts...>;
+};
+
+template <typename Storage, typename... Ts>
+using variant_storage_t = typename variant_storage_selector<Storage, niche_alternative_index<Ts...>(), Ts...>::type;
+
+template <typename Storage, typename Function>
+void try_change_variant(Storage& storage, Function&& function) noexcept(noexcept(std::declval<Function>()()))
+{
+    constexpr_if<noexcept(std::declval<Function>()())>()
+        .then([&](auto) noexcept
+        {
+            function();
+        })
+        .else_([&](auto)
+        {
+            try
+            {
+                function();
+            }
+            catch (...)
+            {
+                storage.set_index(variant_npos);
+                throw;
+            }
+        })(nothing);
+}
+
+// NOTE: defines the special members of variant, trivially copyable alternatives use the storage directly
+template <typename Storage, typename... Ts>
+class variant_value final
+{
+    using helper = variant_helper<Ts...>;
+
+    using is_copy_constructible = std::conjunction<std::is_copy_constructible<Ts>...>;
+    using is_move_constructible = std::conjunction<std::is_move_constructible<Ts>...>;
+    using is_copy_assignable    = std::conjunction<std::is_copy_assignable<Ts>...>;
+    using is_move_assignable    = std::conjunction<std::is_move_assignable<Ts>...>;
+
+    using is_nothrow_copy_constructible = std::conjunction<std::is_nothrow_copy_constructible<Ts>...>;
+    using is_nothrow_move_constructible = std::conjunction<std::is_nothrow_move_constructible<Ts>...>;
+    using is_nothrow_copy_assignable    = std::conjunction<std::is_nothrow_copy_assignable<Ts>...>;
+    using is_nothrow_move_assignable    = std::conjunction<std::is_nothrow_move_assignable<Ts>...>;
+    using is_nothrow_destructible       = std::conjunction<std::is_nothrow_destructible<Ts>...>;
+public:
+
+    variant_value() noexcept
+        : storage()
+    {
+    }
+
+    variant_value(const variant_value& that) noexcept(is_nothrow_copy_constructible::value)
+        : storage()
+    {
+        constexpr_if<is_copy_constructible::value>()
+            .then([&](auto) noexcept(is_nothrow_copy_constructible::value)
+            {
+                copy(that);
+            })
+            .else_([](auto) noexcept
+            {
+                static_assert(false, "Variant isn't copy constructible");
+            })(nothing);
+    }
+
+    variant_value(variant_value&& that) noexcept(is_nothrow_move_constructible::value)
+        : storage()
+    {
+        constexpr_if<is_move_constructible::value>()
+            .then([&](auto) noexcept(is_nothrow_move_constructible::value)
+            {
+                move(std::move(that));
+            })
+            .else_([](auto) noexcept
+            {
+                static_assert(false, "Variant isn't move constructible");
+            })(nothing);
+    }
+
+    ~variant_value() noexcept(is_nothrow_destructible::value)
+    {
+        destroy();
+    }
+
+    variant_value& operator= (const variant_value& that) noexcept(is_nothrow_destructible::value       &&
+                                                                  is_nothrow_copy_constructible::value &&
+                                                                  is_nothrow_copy_assignable::value)
+    {
+        constexpr_if<is_copy_constructible::value &&
+                     is_copy_assignable::value>()
+            .then([&](auto) noexcept(is_nothrow_destructible::value       &&
+                                     is_nothrow_copy_constructible::value &&
+                                     is_nothrow_copy_assignable::value)
+            {
+                assign(that);
+            })
+            .else_([](auto) noexcept
+            {
+                static_assert(is_copy_constructible::value, "Varint isn't copy constructible");
+                static_assert(is_copy_assignable::value, "Varint isn't copy assignable");
+            })(nothing);
+
+        return *this;
+    }
+
+    variant_value& operator= (variant_value&& that) noexcept(is_nothrow_destructible::value       &&
+                                                             is_nothrow_move_constructible::value &&
+                                                             is_nothrow_move_assignable::value)
+    {
+        constexpr_if<is_move_constructible::value &&
+                     is_move_assignable::value>()
+            .then([&](auto) noexcept(is_nothrow_destructible::value       &&
+                                     is_nothrow_move_constructible::value &&
+                                     is_nothrow_move_assignable::value)
+            {
+                assign(std::move(that));
+            })
+            .else_([](auto) noexcept
+            {
+                static_assert(is_move_constructible::value, "Varint isn't move constructible");
+                static_assert(is_move_assignable::value, "Varint isn't move assignable");
+            })(nothing);
+
+        return *this;
+    }
+
+    void* pointer() noexcept
+    {
+        return storage.pointer();
+    }
+
+    const void* pointer() const noexcept
+    {
+        return storage.pointer();
+    }
+
+    size_t index() const noexcept
+    {
+        return storage.index();
+    }
+
+    void set_index(const size_t index) noexcept
+    {
+        storage.set_index(index);
+    }
+
+private:
+
+    void destroy() noexcept(is_nothrow_destructible::value)
     {
-        std::terminate(); // dummy terminate
+        const auto index = this->index();
+        if (index == variant_npos) return;
+        helper::destroy(index, pointer());
+    }
+
+    void copy(const variant_value& that) noexcept(is_nothrow_copy_constructible::value)
+    {
+        const auto index = that.index();
+        if (index == variant_npos) return set_index(variant_npos);
+
+        helper::copy(index, that.pointer(), pointer());
+        set_index(index);
+    }
+
+    void move(variant_value&& that) noexcept(is_nothrow_move_constructible::value)
+    {
+        const auto index = that.index();
+        if (index == variant_npos) return set_index(variant_npos);
+
+        helper::move(index, that.pointer(), pointer());
+        set_index(index);
     }
+
+    void assign(const variant_value& that) noexcept(is_nothrow_copy_assignable::value &&
+                                                    is_nothrow_destructible::value    &&
+                                                    is_nothrow_copy_constructible::value)
+    {
+        const auto index = this->index();
+        if (index == that.index())
+        {
+            if (index == variant_npos) return;
+
+            try_change_variant(storage, [&]() noexcept(is_nothrow_copy_assignable::value)
+            {
+                helper::assign(index, that.pointer(), pointer());
+            });
+        }
+        else
+        {
+            destroy();
+
+            try_change_variant(storage, [&]() noexcept(is_nothrow_copy_constructible::value)
+            {
+                copy(that);
+            });
+        }
+    }
+
+    void assign(variant_value&& that) noexcept(is_nothrow_move_assignable::value &&
+                                               is_nothrow_destructible::value    &&
+                                               is_nothrow_move_constructible::value)
+    {
+        const auto index = this->index();
+        if (index == that.index())
+        {
+            if (index == variant_npos) return;
+
+            try_change_variant(storage, [&]() noexcept(is_nothrow_move_assignable::value)
+            {
+                helper::move_assign(index, that.pointer(), pointer());
+            });
+        }
+        else
+        {
+            destroy();
+
+            try_change_variant(storage, [&]() noexcept(is_nothrow_move_constructible::value)
+            {
+                move(std::move(that));
+            });
+        }
+    }
+
+    Storage storage;
 };
 
+template <typename Storage, typename... Ts>
+using variant_value_t = std::conditional_t<std::conjunction_v<std::is_trivially_copyable<Ts>...>,
+                                           Storage,
+                                           variant_value<Storage, Ts...>>;
+
 template <typename Function, typename T>
 using is_nothrow_match_call = std::bool_constant<noexcept(std::declval<Function>()(std::declval<T>()))>;
 
@@ -202,28 +570,117 @@ constexpr bool is_nothrow_match_function_call() noexcept
     return std::conjunction_v<is_nothrow_match_call<Function, Ts>...>;
 }
 
-} // detail namespaces
+template <typename Variant>
+struct variant_traits;
+
+template <typename... Ts>
+struct variant_traits<variant<Ts...>> final
+{
+    using types = type_list<Ts...>;
+
+    static constexpr size_t size = sizeof...(Ts);
+
+    template <size_t Index>
+    using alternative = std::tuple_element_t<Index, std::tuple<Ts...>>;
+
+    template <typename T>
+    static constexpr bool has_alternative = type_list_ops::contains_v<types, T>;
+};
 
-EXSTREAM_MSVC_SUPPRESS_WARNINGS_PUSH(4521 4522)
+template <typename Variant>
+using variant_traits_t = variant_traits<remove_cvr_t<Variant>>;
+
+// NOTE: variants indices are flattened in the row-major order, the last variant index changes the fastest
+template <size_t Position, typename... Variants>
+constexpr size_t unflatten_variant_index(size_t flatIndex) noexcept
+{
+    constexpr size_t sizes[] = { variant_traits_t<Variants>::size... };
+
+    for (size_t i = sizeof...(Variants) - 1; i > Position; --i)
+        flatIndex /= sizes[i];
+
+    return flatIndex % sizes[Position];
+}
+
+template <size_t FlatIndex, typename Function, typename... Variants, size_t... Positions>
+decltype(auto) match_alternatives(std::index_sequence<Positions...>, Function&& function, Variants&&... variants)
+{
+    return std::forward<Function>(function)(
+        std::forward<Variants>(variants).template get<typename variant_traits_t<Variants>::template alternative<unflatten_variant_index<Positions, Variants...>(FlatIndex)>>()...);
+}
+
+template <typename... Variants>
+constexpr size_t flat_variant_size() noexcept
+{
+    constexpr size_t sizes[] = { variant_traits_t<Variants>::size... };
+
+    size_t result = 1;
+    for (const auto size : sizes)
+        result *= size;
+
+    return result;
+}
+
+template <typename Function, typename... Variants>
+struct multi_variant_helper final
+{
+    using positions = std::index_sequence_for<Variants...>;
+
+    static constexpr size_t size = flat_variant_size<Variants...>();
+
+    template <size_t FlatIndex>
+    using alternatives_result = decltype(match_alternatives<FlatIndex>(positions(), std::declval<Function>(), std::declval<Variants>()...));
+
+    // NOTE: the range of the combinations is halved on every step, so the instantiation depth
+    //       is logarithmic for thousands of combinations
+    template <size_t First, size_t Count>
+    struct common_result final
+    {
+        using type = std::common_type_t<typename common_result<First, Count / 2>::type,
+                                        typename common_result<First + Count / 2, Count - Count / 2>::type>;
+    };
+
+    template <size_t First>
+    struct common_result<First, 1> final
+    {
+        using type = alternatives_result<First>;
+    };
+
+    using result_type = typename common_result<0, size>::type;
+
+    static result_type invoke(const size_t flatIndex, Function&& function, Variants&&... variants)
+    {
+        return dispatch(std::make_index_sequence<size>(), flatIndex, std::forward<Function>(function), std::forward<Variants>(variants)...);
+    }
+
+private:
+
+    template <size_t... FlatIndices>
+    EXSTREAM_FORCEINLINE static result_type dispatch(std::index_sequence<FlatIndices...>, const size_t flatIndex, Function&& function, Variants&&... variants)
+    {
+        using function_t = result_type (*)(Function&&, Variants&&...);
+        static constexpr function_t table[] = { &invoke_alternatives<FlatIndices>... };
+        return table[flatIndex](std::forward<Function>(function), std::forward<Variants>(variants)...);
+    }
+
+    template <size_t FlatIndex>
+    static result_type invoke_alternatives(Function&& function, Variants&&... variants)
+    {
+        return match_alternatives<FlatIndex>(positions(), std::forward<Function>(function), std::forward<Variants>(variants)...);
+    }
+};
+
+} // detail namespaces
 
 template <typename... Ts>
 class variant final
 {
-    struct valueless_by_exception final {};
-
     using types = type_list<Ts...>;
     using helper = detail::variant_helper<Ts...>;
 
-    using is_copy_constructible = std::conjunction<std::is_copy_constructible<Ts>...>;
-    using is_move_constructible = std::conjunction<std::is_move_constructible<Ts>...>;
-    using is_copy_assignable    = std::conjunction<std::is_copy_assignable<Ts>...>;
-    using is_move_assignable    = std::conjunction<std::is_move_assignable<Ts>...>;
-    using is_swappable          = std::conjunction<std::is_swappable<std::add_lvalue_reference_t<Ts>>...>;
+    using is_swappable = std::conjunction<std::is_swappable<std::add_lvalue_reference_t<Ts>>...>;
 
-    using is_nothrow_copy_constructible = std::conjunction<std::is_nothrow_copy_constructible<Ts>...>;
     using is_nothrow_move_constructible = std::conjunction<std::is_nothrow_move_constructible<Ts>...>;
-    using is_nothrow_copy_assignable    = std::conjunction<std::is_nothrow_copy_assignable<Ts>...>;
-    using is_nothrow_move_assignable    = std::conjunction<std::is_nothrow_move_assignable<Ts>...>;
     using is_nothrow_destructible       = std::conjunction<std::is_nothrow_destructible<Ts>...>;
     using is_nothrow_swappable          = std::conjunction<std::is_nothrow_swappable<std::add_lvalue_reference_t<Ts>>...>;
 
@@ -238,8 +695,7 @@ public:
 
     template <typename T>
     explicit variant(type_t<T> type) noexcept(std::is_nothrow_default_constructible_v<T>)
-        : storage(),
-          index_(type_list_ops::index_of_v<types, T>)
+        : storage()
     {
         using namespace type_list_ops;
 
@@ -259,10 +715,9 @@ public:
             })(type);
     }
 
-    template <typename T>
+    template <typename T, typename = std::enable_if_t<!std::is_same_v<remove_cvr_t<T>, variant>>>
     explicit variant(T&& value) noexcept(std::is_nothrow_constructible_v<remove_cvr_t<T>, T>)
-        : storage(),
-          index_(type_list_ops::index_of_v<types, T>)
+        : storage()
     {
         using namespace type_list_ops;
         using value_type = remove_cvr_t<T>;
@@ -285,8 +740,7 @@ public:
 
     template <typename T, typename... Args>
     explicit variant(in_place_type_t<T> type, Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
-        : storage(),
-          index_(type_list_ops::index_of_v<types, T>)
+        : storage()
     {
         using namespace type_list_ops;
 
@@ -307,47 +761,12 @@ public:
             })(type, std::forward<Args>(args)...);
     }
 
-    variant(variant& that) noexcept(is_nothrow_copy_constructible::value)
-        : variant(std::as_const(that))
-    {
-    }
-
-    variant(const variant& that) noexcept(is_nothrow_copy_constructible::value)
-        : storage(),
-          index_(that.index_)
-    {
-        constexpr_if<is_copy_constructible::value>()
-            .then([&](auto) noexcept(is_nothrow_copy_constructible::value)
-            {
-                copy(that);
-            })
-            .else_([](auto) noexcept
-            {
-                static_assert(false, "Variant isn't copy constructible");
-            })(nothing);
-    }
-
-    variant(variant&& that) noexcept(is_nothrow_move_constructible::value)
-        : storage(),
-          index_(that.index_)
-    {
-        constexpr_if<is_move_constructible::value>()
-            .then([&](auto) noexcept(is_nothrow_move_constructible::value)
-            {
-                move(std::move(that));
-            })
-            .else_([](auto) noexcept
-            {
-                static_assert(false, "Variant isn't move constructible");
-            })(nothing);
-    }
+    variant(const variant&) = default;
+    variant(variant&&) = default;
 
-    ~variant() noexcept(is_nothrow_destructible::value)
-    {
-        destroy();
-    }
+    ~variant() = default;
 
-    template <typename T>
+    template <typename T, typename = std::enable_if_t<!std::is_same_v<remove_cvr_t<T>, variant>>>
     variant& operator= (T&& that) noexcept(is_nothrow_destructible::value                   &&
                                            std::is_nothrow_assignable_v<remove_cvr_t<T>&, T> &&
                                            std::is_nothrow_constructible_v<remove_cvr_t<T>, T>)
@@ -366,7 +785,7 @@ public:
                 using val_type = remove_cvr_t<that_reference>;
                 const auto value_type_index = index_of_v<types, val_type>;
 
-                if (index_ == value_type_index)
+                if (index() == value_type_index)
                 {
                     try_change([&]() noexcept(std::is_nothrow_assignable_v<val_type&, that_reference>)
                     {
@@ -380,7 +799,6 @@ public:
                     try_change([&]() noexcept(std::is_nothrow_constructible_v<val_type, that_reference>)
                     {
                         construct<val_type>(std::forward<that_reference>(that));
-                        index_ = value_type_index;
                     });
                 }
             })
@@ -398,54 +816,8 @@ public:
         return *this;
     }
 
-    variant& operator= (variant& that) noexcept(is_nothrow_destructible::value       &&
-                                                is_nothrow_copy_constructible::value &&
-                                                is_nothrow_copy_assignable::value)
-    {
-        return this->operator=(std::as_const(that));
-    }
-
-    variant& operator= (const variant& that) noexcept(is_nothrow_destructible::value       &&
-                                                      is_nothrow_copy_constructible::value &&
-                                                      is_nothrow_copy_assignable::value)
-    {
-        constexpr_if<is_copy_constructible::value &&
-                     is_copy_assignable::value>()
-            .then([&](auto) noexcept(is_nothrow_destructible::value       &&
-                                     is_nothrow_copy_constructible::value &&
-                                     is_nothrow_copy_assignable::value)
-            {
-                assign(that);
-            })
-            .else_([](auto) noexcept
-            {
-                static_assert(is_copy_constructible::value, "Varint isn't copy constructible");
-                static_assert(is_copy_assignable::value, "Varint isn't copy assignable");
-            })(nothing);
-
-        return *this;
-    }
-
-    variant& operator= (variant&& that) noexcept(is_nothrow_destructible::value       &&
-                                                 is_nothrow_move_constructible::value &&
-                                                 is_nothrow_move_assignable::value)
-    {
-        constexpr_if<is_move_constructible::value &&
-                     is_move_assignable::value>()
-            .then([&](auto) noexcept(is_nothrow_destructible::value       &&
-                                     is_nothrow_move_constructible::value &&
-                                     is_nothrow_move_assignable::value)
-            {
-                assign(std::move(that));
-            })
-            .else_([](auto) noexcept
-            {
-                static_assert(is_move_constructible::value, "Varint isn't move constructible");
-                static_assert(is_move_assignable::value, "Varint isn't move assignable");
-            })(nothing);
-
-        return *this;
-    }
+    variant& operator= (const variant&) = default;
+    variant& operator= (variant&&) = default;
 
     template <typename T, typename... Args>
     void emplace(in_place_type_t<T>, Args&&... arguments) noexcept(std::is_nothrow_constructible_v<T, Args...> && is_nothrow_destructible::value)
@@ -464,7 +836,6 @@ public:
                 try_change([&]() noexcept(std::is_nothrow_constructible_v<type_t, decltype(args)...>)
                 {
                     construct<type_t>(std::forward<decltype(args)>(args)...);
-                    index_ = index_of_v<types, type_t>;
                 });
 
                 EXSTREAM_UNUSED(type);
@@ -481,23 +852,23 @@ public:
     template <typename T>
     bool contains() const noexcept
     {
-        return index_ == type_list_ops::index_of_v<types, T>;
+        return index() == type_list_ops::index_of_v<types, T>;
     }
 
     bool is_valueless_by_exception() const noexcept
     {
-        return index_ == variant_npos;
+        return index() == variant_npos;
     }
 
     size_t index() const noexcept
     {
-        return index_;
+        return storage.index();
     }
 
     size_t hash() const noexcept
     {
         return is_valueless_by_exception() ? size_t(0)
-                                           : helper::hash(helper_index(), raw_pointer());
+                                           : helper::hash(index(), raw_pointer());
     }
 
     template <typename T>
@@ -530,7 +901,7 @@ public:
         using namespace type_list_ops;
         static_assert(contains_v<types, T>, "Invalid variant type");
 
-        return (index_ == index_of_v<types, T>) ? option<T&>(*pointer<T>())
+        return (index() == index_of_v<types, T>) ? option<T&>(*pointer<T>())
                                                 : option<T&>();
     }
 
@@ -540,7 +911,7 @@ public:
         using namespace type_list_ops;
         static_assert(contains_v<types, T>, "Invalid variant type");
 
-        return (index_ == index_of_v<types, T>) ? option<const T&>(*pointer<T>())
+        return (index() == index_of_v<types, T>) ? option<const T&>(*pointer<T>())
                                                 : option<const T&>();
     }
 
@@ -554,8 +925,8 @@ public:
         return constexpr_if<is_function_invokable::value>()
             .then([this](auto&& func) noexcept(detail::is_nothrow_match_function_call<decltype(func), Ts&...>()) -> decltype(auto)
             {
-                using result = std::common_type_t<std::result_of_t<decltype(func)(Ts&)>...>;
-                return helper::template invoke<result>(helper_index(), raw_pointer(), std::forward<decltype(func)>(func));
+                using result = std::common_type_t<result_of_t<decltype(func)(Ts&)>...>;
+                return helper::template invoke<result>(index(), raw_pointer(), std::forward<decltype(func)>(func));
             })
             .else_([](auto) noexcept
             {
@@ -573,8 +944,8 @@ public:
         return constexpr_if<is_function_invokable::value>()
             .then([this](auto&& func) noexcept(detail::is_nothrow_match_function_call<decltype(func), const Ts&...>()) -> decltype(auto)
             {
-                using result = std::common_type_t<std::result_of_t<decltype(func)(const Ts&)>...>;
-                return helper::template invoke<result>(helper_index(), raw_pointer(), std::forward<decltype(func)>(func));
+                using result = std::common_type_t<result_of_t<decltype(func)(const Ts&)>...>;
+                return helper::template invoke<result>(index(), raw_pointer(), std::forward<decltype(func)>(func));
             })
             .else_([](auto) noexcept
             {
@@ -592,8 +963,8 @@ public:
         return constexpr_if<is_function_invokable::value>()
             .then([this](auto&& func) noexcept(detail::is_nothrow_match_function_call<decltype(func), Ts&&...>()) -> decltype(auto)
             {
-                using result = std::common_type_t<std::result_of_t<decltype(func)(Ts&&)>...>;
-                return helper::template invoke_on_rvalue<result>(helper_index(), raw_pointer(), std::forward<decltype(func)>(func));
+                using result = std::common_type_t<result_of_t<decltype(func)(Ts&&)>...>;
+                return helper::template invoke_on_rvalue<result>(index(), raw_pointer(), std::forward<decltype(func)>(func));
             })
             .else_([](auto) noexcept
             {
@@ -610,7 +981,7 @@ public:
                 if (lhs.index() == rhs.index())
                 {
                     if (lhs.is_valueless_by_exception()) return;
-                    helper::swap(lhs.helper_index(), lhs.raw_pointer(), rhs.raw_pointer());
+                    helper::swap(lhs.index(), lhs.raw_pointer(), rhs.raw_pointer());
                 }
                 else
                 {
@@ -644,17 +1015,12 @@ private:
 
     void* raw_pointer() noexcept
     {
-        return reinterpret_cast<void*>(std::addressof(storage));
+        return storage.pointer();
     }
 
     const void* raw_pointer() const noexcept
     {
-        return reinterpret_cast<const void*>(std::addressof(storage));
-    }
-
-    size_t helper_index() const noexcept
-    {
-        return sizeof...(Ts) - index_ - 1;
+        return storage.pointer();
     }
 
     template <typename T>
@@ -671,32 +1037,21 @@ private:
 
     void destroy() noexcept(is_nothrow_destructible::value)
     {
-        if (index_ == variant_npos) return;
-        helper::destroy(helper_index(), raw_pointer());
+        const auto index = this->index();
+        if (index == variant_npos) return;
+        helper::destroy(index, raw_pointer());
     }
 
     void construct_valueless() noexcept
     {
-        construct<valueless_by_exception>();
-        index_ = variant_npos;
+        storage.set_index(variant_npos);
     }
 
     template <typename T, typename... Args>
     void construct(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
     {
         new (pointer<T>()) T(std::forward<Args>(args)...);
-    }
-
-    void copy(const variant& that) noexcept(is_nothrow_copy_constructible::value)
-    {
-        if (that.index_ == variant_npos) construct_valueless();
-        else                             helper::copy(that.helper_index(), that.raw_pointer(), raw_pointer());
-    }
-
-    void move(variant&& that) noexcept(is_nothrow_move_constructible::value)
-    {
-        if (that.index_ == variant_npos) construct_valueless();
-        else                             helper::move(that.helper_index(), that.raw_pointer(), raw_pointer());
+        storage.set_index(type_list_ops::index_of_v<types, T>);
     }
 
     template <typename T, typename U>
@@ -705,92 +1060,40 @@ private:
         (*pointer<T>()) = std::forward<U>(that);
     }
 
-    void assign(const variant& that) noexcept(is_nothrow_copy_assignable::value &&
-                                              is_nothrow_destructible::value    &&
-                                              is_nothrow_copy_constructible::value)
-    {
-        if (index_ == that.index_)
-        {
-            if (index_ == variant_npos) return;
-
-            try_change([&]() noexcept(is_nothrow_copy_assignable::value)
-            {
-                helper::assign(helper_index(), that.raw_pointer(), raw_pointer());
-            });
-        }
-        else
-        {
-            destroy();
-
-            try_change([&]() noexcept(is_nothrow_copy_assignable::value)
-            {
-                copy(that);
-                index_ = that.index_;
-            });
-        }
-    }
-
-    void assign(variant&& that) noexcept(is_nothrow_move_assignable::value &&
-                                         is_nothrow_destructible::value    &&
-                                         is_nothrow_move_constructible::value)
-    {
-        if (index_ == that.index_)
-        {
-            if (index_ == variant_npos) return;
-
-            try_change([&]() noexcept(is_nothrow_move_assignable::value)
-            {
-                helper::move_assign(helper_index(), that.raw_pointer(), raw_pointer());
-            });
-        }
-        else
-        {
-            destroy();
-
-            try_change([&]() noexcept(is_nothrow_move_constructible::value)
-            {
-                move(std::move(that));
-                index_ = that.index_;
-            });
-        }
-    }
-
     template <typename Function>
     void try_change(Function&& function) noexcept(noexcept(std::declval<Function>()()))
     {
-        constexpr_if<noexcept(std::declval<Function>()())>()
-            .then([&](auto) noexcept
-            {
-                function();
-            })
-            .else_([&](auto)
-            {
-                try
-                {
-                    function();
-                }
-                catch (...)
-                {
-                    construct_valueless();
-                    throw;
-                }
-            })(nothing);
+        detail::try_change_variant(storage, std::forward<Function>(function));
     }
 
-    using storage_t = std::aligned_union_t<sizeof(valueless_by_exception), Ts...>;
+    using storage_t = detail::variant_value_t<detail::variant_storage_t<std::aligned_union_t<1, Ts...>, Ts...>, Ts...>;
 
     storage_t storage;
-    size_t index_;
 };
 
-EXSTREAM_MSVC_WARNINGS_POP
-
 template <typename... Ts>
 void swap(variant<Ts...>& lhs, variant<Ts...>& rhs) noexcept(noexcept(variant<Ts...>::swap(lhs, rhs)))
 {
     variant<Ts...>::swap(lhs, rhs);
 }
 
+// NOTE: invokes the function with the current values of all variants, the function should handle every combination of types
+template <typename Function, typename... Variants>
+decltype(auto) match(Function&& function, Variants&&... variants)
+{
+    static_assert(sizeof...(Variants) != 0, "At least one variant is required");
+
+    bool valueless = false;
+    (void)std::initializer_list<int>{ (void(valueless = valueless || variants.is_valueless_by_exception()), 0)... };
+    if (valueless) throw bad_variant_access();
+
+    size_t flatIndex = 0;
+    (void)std::initializer_list<int>{ (void(flatIndex = flatIndex * detail::variant_traits_t<Variants>::size + variants.index()), 0)... };
+
+    using helper = detail::multi_variant_helper<Function, Variants...>;
+    return helper::invoke(flatIndex, std::forward<Function>(function), std::forward<Variants>(variants)...);
+}
+
 } // exstream namespace
 
 namespace std {
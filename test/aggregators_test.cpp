@@ -0,0 +1,178 @@
+#include "test.hpp"
+
+#include "stream_of.hpp"
+#include "make_array.hpp"
+#include "aggregators/aggregators.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+using namespace exstream;
+using namespace testing;
+
+#define TEST_CASE_NAME AggregatorsTest
+
+static const auto test_values = make_array(2, 4, 4, 4, 5, 5, 7, 9);
+
+static std::vector<double> make_uniform(const size_t count, const unsigned seed)
+{
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    std::vector<double> result(count);
+    for (auto& value : result)
+        value = distribution(engine);
+
+    return result;
+}
+
+TEST(TEST_CASE_NAME, running_stats_Test)
+{
+    const auto stats = stream_of(test_values).aggregate(running_stats());
+
+    EXPECT_THAT(stats.count(), Eq(8u));
+    EXPECT_THAT(stats.sum(), DoubleEq(40.0));
+    EXPECT_THAT(stats.mean(), DoubleEq(5.0));
+    EXPECT_THAT(stats.variance(), DoubleEq(4.0));
+    EXPECT_THAT(stats.sample_variance(), DoubleEq(32.0 / 7));
+    EXPECT_THAT(stats.stddev(), DoubleEq(2.0));
+    EXPECT_THAT(stats.min(), DoubleEq(2.0));
+    EXPECT_THAT(stats.max(), DoubleEq(9.0));
+
+    auto left = stream_of(test_values).filter([](auto x) { return x < 5; }).aggregate(running_stats());
+    const auto right = stream_of(test_values).filter([](auto x) { return x >= 5; }).aggregate(running_stats());
+    left.merge(right);
+
+    EXPECT_THAT(left.count(), Eq(8u));
+    EXPECT_THAT(left.mean(), DoubleEq(5.0));
+    EXPECT_THAT(left.variance(), DoubleNear(4.0, 1e-12));
+    EXPECT_THAT(left.min(), DoubleEq(2.0));
+    EXPECT_THAT(left.max(), DoubleEq(9.0));
+
+    const auto empty = stream_of(std::vector<int>()).aggregate(running_stats());
+    EXPECT_THAT(empty.count(), Eq(0u));
+    EXPECT_TRUE(std::isnan(empty.mean()));
+}
+
+TEST(TEST_CASE_NAME, tdigest_Test)
+{
+    const auto values = make_uniform(100000, 42);
+    auto digest = stream_of(values).aggregate(tdigest());
+
+    EXPECT_THAT(digest.count(), DoubleEq(100000.0));
+    EXPECT_THAT(digest.centroids_count(), Le(100u));
+    EXPECT_THAT(digest.median(), DoubleNear(0.5, 0.01));
+    EXPECT_THAT(digest.quantile(0.1), DoubleNear(0.1, 0.01));
+    EXPECT_THAT(digest.quantile(0.99), DoubleNear(0.99, 0.002));
+    EXPECT_THAT(digest.quantile(0.0), DoubleEq(digest.min()));
+    EXPECT_THAT(digest.quantile(1.0), DoubleEq(digest.max()));
+
+    auto left = tdigest();
+    auto right = tdigest();
+    for (size_t i = 0; i < values.size(); ++i)
+        ((i % 2 == 0) ? left : right).add(values[i]);
+
+    left.merge(right);
+    EXPECT_THAT(left.count(), DoubleEq(100000.0));
+    EXPECT_THAT(left.median(), DoubleNear(0.5, 0.01));
+
+    auto single = stream_of(make_array(7)).aggregate(tdigest());
+    EXPECT_THAT(single.median(), DoubleEq(7.0));
+    EXPECT_TRUE(std::isnan(tdigest().median()));
+}
+
+TEST(TEST_CASE_NAME, hyperloglog_Test)
+{
+    std::vector<int> values;
+    for (int i = 0; i < 200000; ++i)
+        values.push_back(i % 50000);
+
+    const auto sketch = stream_of(values).aggregate(hyperloglog());
+    EXPECT_THAT(sketch.estimate(), DoubleNear(50000.0, 50000.0 * 0.05));
+
+    const auto small = stream_of(test_values).aggregate(hyperloglog());
+    EXPECT_THAT(small.count(), Eq(5u));
+
+    auto left = hyperloglog();
+    auto right = hyperloglog();
+    for (int i = 0; i < 20000; ++i)
+        left.add(std::to_string(i));
+    for (int i = 10000; i < 30000; ++i)
+        right.add(std::to_string(i));
+
+    left.merge(right);
+    EXPECT_THAT(left.estimate(), DoubleNear(30000.0, 30000.0 * 0.05));
+    EXPECT_THAT(hyperloglog().count(), Eq(0u));
+}
+
+TEST(TEST_CASE_NAME, bloom_filter_Test)
+{
+    auto filter = bloom_filter<>(10000, 0.01);
+    EXPECT_THAT(filter.hash_count(), Eq(7u));
+    EXPECT_THAT(filter.bit_count(), Ge(95851u));
+
+    size_t added = 0;
+    for (int i = 0; i < 10000; ++i)
+        added += filter.add(i * 2) ? 1 : 0;
+
+    EXPECT_THAT(added, Ge(9900u));
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        EXPECT_FALSE(filter.add(i * 2));
+        EXPECT_TRUE(filter.contains(i * 2));
+    }
+
+    size_t falsePositives = 0;
+    for (int i = 0; i < 10000; ++i)
+        falsePositives += filter.contains(i * 2 + 1) ? 1 : 0;
+
+    EXPECT_THAT(falsePositives, Lt(200u));
+
+    auto other = bloom_filter<>(10000, 0.01);
+    other.add(-1);
+    filter.merge(other);
+    EXPECT_TRUE(filter.contains(-1));
+}
+
+TEST(TEST_CASE_NAME, space_saving_Test)
+{
+    std::vector<int> values;
+    for (int i = 0; i < 10000; ++i)
+    {
+        values.push_back(i);
+        if (i % 2 == 0) values.push_back(-1);
+        if (i % 4 == 0) values.push_back(-2);
+        if (i % 10 == 0) values.push_back(-3);
+    }
+
+    const auto sketch = stream_of(values).aggregate(space_saving<int>(20));
+    const auto top = sketch.top();
+
+    ASSERT_THAT(top.size(), Eq(20u));
+    EXPECT_THAT(top[0].value, Eq(-1));
+    EXPECT_THAT(top[1].value, Eq(-2));
+    EXPECT_THAT(top[2].value, Eq(-3));
+
+    const auto bound = sketch.count() / 20;
+    EXPECT_THAT(top[0].count, AllOf(Ge(5000u), Le(5000u + bound)));
+    EXPECT_THAT(top[1].count, AllOf(Ge(2500u), Le(2500u + bound)));
+    EXPECT_THAT(top[2].count, AllOf(Ge(1000u), Le(1000u + bound)));
+    EXPECT_THAT(top[0].count - top[0].error, Le(5000u));
+
+    EXPECT_THAT(sketch.estimate(-1), Eq(top[0].count));
+    EXPECT_THAT(sketch.estimate(123456), Le(bound));
+
+    auto exact = space_saving<std::string>(3);
+    for (const auto* value : { "a", "b", "a", "c", "a", "b" })
+        exact.add(value);
+
+    EXPECT_THAT(exact.top()[0].value, Eq("a"));
+    EXPECT_THAT(exact.top()[0].count, Eq(3u));
+    EXPECT_THAT(exact.top()[0].error, Eq(0u));
+    EXPECT_THAT(exact.estimate("d"), Eq(1u));
+}
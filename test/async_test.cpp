@@ -0,0 +1,257 @@
+#include "test.hpp"
+
+#include "stream_of.hpp"
+#include "executor.hpp"
+#include "channel.hpp"
+#include "collectors/vector_collector.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+using namespace exstream;
+using namespace testing;
+
+#define TEST_CASE_NAME AsyncTest
+
+static std::vector<int> make_values(const size_t count)
+{
+    std::vector<int> values(count);
+    std::iota(values.begin(), values.end(), 0);
+    return values;
+}
+
+TEST(TEST_CASE_NAME, async_Test)
+{
+    const auto values = make_values(10000);
+    const auto caller = std::this_thread::get_id();
+
+    auto result = stream_of(values)
+        .map([&](auto x)
+        {
+            EXPECT_NE(std::this_thread::get_id(), caller);
+            return x * 2;
+        })
+        .async(thread_executor(), 16)
+        .filter([](auto x) { return x % 3 == 0; })
+        .collect(to_vector());
+
+    ASSERT_THAT(result.size(), Eq(3334u));
+    EXPECT_THAT(result.front(), Eq(0));
+    EXPECT_THAT(result.back(), Eq(19998));
+    EXPECT_TRUE(std::is_sorted(result.begin(), result.end()));
+
+    EXPECT_THAT(stream_of(values).async(thread_executor()).count(), Eq(10000u));
+    EXPECT_THAT(stream_of(values).filter([](auto x) { return x < 10; }).async(thread_executor(), 4).count(), Eq(10u));
+
+    using meta = decltype(stream_of(values).async(thread_executor()))::meta;
+    EXPECT_TRUE((std::is_same_v<meta, decltype(stream_of(values))::meta>));
+}
+
+TEST(TEST_CASE_NAME, async_exception_Test)
+{
+    const auto values = make_values(100);
+
+    auto run = [&]
+    {
+        stream_of(values)
+            .map([](auto x)
+            {
+                if (x == 50) throw std::runtime_error("Upstream failure");
+                return x;
+            })
+            .async(thread_executor(), 8)
+            .foreach([](auto) {});
+    };
+
+    EXPECT_THROW(run(), std::runtime_error);
+}
+
+TEST(TEST_CASE_NAME, async_cancellation_Test)
+{
+    const auto values = make_values(100000);
+    const auto take_first = [](const auto& stream)
+    {
+        auto iter = stream.get_iterator();
+        return iter.next();
+    };
+
+    size_t produced = 0;
+    const auto first = take_first(stream_of(values)
+        .map([&](auto x) { ++produced; return x; })
+        .async(thread_executor(), 8));
+
+    EXPECT_THAT(first, Eq(0));
+    EXPECT_THAT(produced, Lt(values.size()));
+}
+
+TEST(TEST_CASE_NAME, async_distinct_Test)
+{
+    std::vector<std::string> values;
+    for (int i = 0; i < 10000; ++i)
+        values.push_back(std::to_string(i % 1000));
+
+    bool first = true;
+    auto result = stream_of(values)
+        .map([](const auto& x) { return x + x; })
+        .distinct()
+        .async(thread_executor(), 2048)
+        .map([&](const auto& x)
+        {
+            // NOTE: lets the worker reach the end while the queue is full of references to the distinct elements
+            if (std::exchange(first, false)) std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            return x;
+        })
+        .collect(to_vector());
+
+    ASSERT_THAT(result.size(), Eq(1000u));
+    EXPECT_THAT(result.front(), Eq("00"));
+    EXPECT_THAT(result.back(), Eq("999999"));
+}
+
+TEST(TEST_CASE_NAME, par_map_Test)
+{
+    const auto values = make_values(10000);
+    const thread_pool pool(4);
+
+    auto result = stream_of(values)
+        .filter([](auto x) { return x % 2 == 0; })
+        .par_map([](auto x) { return std::to_string(x); }, pool, 16, 4)
+        .collect(to_vector());
+
+    ASSERT_THAT(result.size(), Eq(5000u));
+    for (size_t i = 0; i < result.size(); ++i)
+        ASSERT_THAT(result[i], Eq(std::to_string(i * 2)));
+
+    EXPECT_THAT(stream_of(values).par_map([](auto x) { return x; }, pool).count(), Eq(10000u));
+
+    auto sum = 0ll;
+    stream_of(values)
+        .par_map([](auto x) { return static_cast<long long>(x) * x; }, pool)
+        .foreach([&](auto x) { sum += x; });
+
+    EXPECT_THAT(sum, Eq(333283335000ll));
+}
+
+TEST(TEST_CASE_NAME, par_map_exception_Test)
+{
+    const auto values = make_values(1000);
+    const thread_pool pool(2);
+
+    auto run = [&]
+    {
+        stream_of(values)
+            .par_map([](auto x)
+            {
+                if (x == 500) throw std::runtime_error("Map failure");
+                return x;
+            }, pool, 8, 2)
+            .foreach([](auto) {});
+    };
+
+    EXPECT_THROW(run(), std::runtime_error);
+}
+
+TEST(TEST_CASE_NAME, par_map_executor_exception_Test)
+{
+    const auto values = make_values(1000);
+    const thread_pool pool(2);
+
+    // NOTE: accepts a few batches and then fails, the accepted batches should still be waited for
+    std::atomic<int> accepted(3);
+    const auto executor = [&](auto&& task)
+    {
+        if (accepted.fetch_sub(1) <= 0) throw std::runtime_error("Executor failure");
+        pool(std::forward<decltype(task)>(task));
+    };
+
+    auto run = [&]
+    {
+        stream_of(values)
+            .par_map([](auto x) { return x; }, executor, 8, 4)
+            .foreach([](auto) {});
+    };
+
+    EXPECT_THROW(run(), std::runtime_error);
+}
+
+TEST(TEST_CASE_NAME, channel_Test)
+{
+    const auto values = make_values(10000);
+    channel<int> queue(16);
+
+    std::thread producer([&]
+    {
+        stream_of(values).map([](auto x) { return x * 2; }).collect(to_channel(queue));
+        queue.close();
+    });
+
+    auto result = stream_of(queue)
+        .filter([](auto x) { return x % 3 == 0; })
+        .collect(to_vector());
+
+    producer.join();
+
+    ASSERT_THAT(result.size(), Eq(3334u));
+    EXPECT_TRUE(std::is_sorted(result.begin(), result.end()));
+    EXPECT_THAT(result.back(), Eq(19998));
+
+    channel<std::string> small(2);
+    EXPECT_TRUE(small.try_push("a"));
+    EXPECT_TRUE(small.try_push("b"));
+    EXPECT_FALSE(small.try_push("c"));
+    EXPECT_THAT(small.try_pop(), Eq(option<std::string>("a")));
+
+    small.close();
+    EXPECT_FALSE(small.push("d"));
+    EXPECT_THAT(small.pop(), Eq(option<std::string>("b")));
+    EXPECT_TRUE(small.pop().empty());
+}
+
+TEST(TEST_CASE_NAME, channel_mpmc_Test)
+{
+    constexpr int producers = 4;
+    constexpr int consumers = 3;
+    constexpr int perProducer = 20000;
+
+    channel<int> queue(8);
+    std::vector<std::vector<int>> received(consumers);
+
+    std::vector<std::thread> consumerThreads;
+    for (int c = 0; c < consumers; ++c)
+        consumerThreads.emplace_back([&, c] { received[c] = stream_of(queue).collect(to_vector()); });
+
+    std::vector<std::thread> producerThreads;
+    for (int p = 0; p < producers; ++p)
+    {
+        producerThreads.emplace_back([&, p]
+        {
+            stream_of(make_values(perProducer))
+                .map([p](auto x) { return x * producers + p; })
+                .collect(to_channel(queue));
+        });
+    }
+
+    for (auto& producer : producerThreads)
+        producer.join();
+
+    queue.close();
+
+    for (auto& consumer : consumerThreads)
+        consumer.join();
+
+    std::vector<int> result;
+    for (const auto& part : received)
+        result.insert(result.end(), part.begin(), part.end());
+
+    std::sort(result.begin(), result.end());
+    EXPECT_THAT(result, ElementsAreArray(make_values(producers * perProducer)));
+}
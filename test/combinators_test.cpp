@@ -0,0 +1,193 @@
+#include "test.hpp"
+
+#include "stream_of.hpp"
+#include "make_array.hpp"
+#include "combinators/combinators.hpp"
+#include "collectors/collectors.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <map>
+#include <set>
+#include <string>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+using namespace exstream;
+using namespace testing;
+
+#define TEST_CASE_NAME CombinatorsTest
+
+static const auto numbers = make_array(1, 2, 3, 4);
+static const auto names = make_array(std::string("one"), std::string("two"), std::string("three"));
+
+TEST(TEST_CASE_NAME, zip_Test)
+{
+    auto result = zip(stream_of(numbers), stream_of(names))
+        .map([](const auto& x) { return std::get<1>(x) + std::to_string(std::get<0>(x)); })
+        .collect(to_vector());
+
+    EXPECT_THAT(result, ElementsAre("one1", "two2", "three3"));
+
+    EXPECT_THAT(zip(stream_of(numbers), stream_of(names)).count(), Eq(3u));
+    EXPECT_THAT(zip(stream_of(numbers), stream_of(numbers).filter([](auto x) { return x > 2; })).count(), Eq(2u));
+
+    auto tuples = zip(stream_of(numbers), stream_of(numbers).map([](auto x) { return x * x; }), stream_of(names))
+        .collect(to_vector());
+
+    EXPECT_THAT(tuples, ElementsAre(std::make_tuple(1, 1, "one"), std::make_tuple(2, 4, "two"), std::make_tuple(3, 9, "three")));
+}
+
+TEST(TEST_CASE_NAME, zip_meta_Test)
+{
+    const std::set<int> ordered = { 1, 2, 3 };
+
+    using ordered_meta = decltype(zip(stream_of(ordered), stream_of(numbers)))::meta;
+    EXPECT_TRUE(ordered_meta::is_ordered);
+    EXPECT_TRUE(ordered_meta::is_distinct);
+
+    using unordered_meta = decltype(zip(stream_of(numbers), stream_of(ordered)))::meta;
+    EXPECT_FALSE(unordered_meta::is_ordered);
+    EXPECT_TRUE(unordered_meta::is_distinct);
+}
+
+TEST(TEST_CASE_NAME, concat_Test)
+{
+    auto result = concat(stream_of(numbers), stream_of(numbers).map([](auto x) { return x * 10; }))
+        .collect(to_vector());
+
+    EXPECT_THAT(result, ElementsAre(1, 2, 3, 4, 10, 20, 30, 40));
+    EXPECT_THAT(concat(stream_of(numbers), stream_of(numbers)).count(), Eq(8u));
+
+    int sum = 0;
+    concat(concat(stream_of(numbers), stream_of(numbers)), stream_of(numbers).filter([](auto x) { return x > 3; }))
+        .foreach([&](auto x) { sum += x; });
+
+    EXPECT_THAT(sum, Eq(24));
+}
+
+TEST(TEST_CASE_NAME, sorted_concat_Test)
+{
+    const std::set<int> low = { 1, 2, 3 };
+    const std::set<int> high = { 5, 6 };
+
+    using unknown_meta = decltype(concat(stream_of(low), stream_of(high)))::meta;
+    EXPECT_FALSE(unknown_meta::is_ordered);
+
+    using sorted_meta = decltype(concat(assume_sorted, stream_of(low), stream_of(high)))::meta;
+    EXPECT_TRUE(sorted_meta::is_ordered);
+    EXPECT_TRUE(sorted_meta::is_distinct);
+    EXPECT_THAT(sorted_meta::order, Eq(Order::Ascending));
+
+    auto result = concat(assume_sorted, stream_of(low), stream_of(high))
+        .distinct()
+        .collect(to_vector());
+
+    EXPECT_THAT(result, ElementsAre(1, 2, 3, 5, 6));
+}
+
+TEST(TEST_CASE_NAME, merge_Test)
+{
+    const std::set<int> odd = { 1, 3, 5, 7 };
+    const std::set<int> small = { 1, 2, 3 };
+
+    EXPECT_THAT(merge(stream_of(odd), stream_of(small)).collect(to_vector()), ElementsAre(1, 1, 2, 3, 3, 5, 7));
+    EXPECT_THAT(merge(stream_of(odd), stream_of(small)).count(), Eq(7u));
+
+    using meta = decltype(merge(stream_of(odd), stream_of(small)))::meta;
+    EXPECT_TRUE(meta::is_ordered);
+    EXPECT_FALSE(meta::is_distinct);
+
+    const std::vector<int> unordered = { 2, 4, 6 };
+    EXPECT_THAT(merge(assume_sorted, stream_of(odd), stream_of(unordered)).collect(to_vector()), ElementsAre(1, 2, 3, 4, 5, 6, 7));
+}
+
+TEST(TEST_CASE_NAME, set_operations_Test)
+{
+    const std::set<int> odd = { 1, 3, 5, 7 };
+    const std::set<int> small = { 1, 2, 3 };
+
+    EXPECT_THAT(set_union(stream_of(odd), stream_of(small)).collect(to_vector()), ElementsAre(1, 2, 3, 5, 7));
+    EXPECT_THAT(set_intersection(stream_of(odd), stream_of(small)).collect(to_vector()), ElementsAre(1, 3));
+    EXPECT_THAT(set_difference(stream_of(odd), stream_of(small)).collect(to_vector()), ElementsAre(5, 7));
+    EXPECT_THAT(set_difference(stream_of(small), stream_of(odd)).collect(to_vector()), ElementsAre(2));
+
+    using union_meta = decltype(set_union(stream_of(odd), stream_of(small)))::meta;
+    EXPECT_TRUE(union_meta::is_ordered);
+    EXPECT_TRUE(union_meta::is_distinct);
+
+    const std::set<int, std::greater<>> descending = { 5, 4, 3 };
+    const std::set<int, std::greater<>> other = { 6, 4, 2 };
+    EXPECT_THAT(set_union(stream_of(descending), stream_of(other)).collect(to_vector()), ElementsAre(6, 5, 4, 3, 2));
+
+    const std::vector<int> sorted = { 1, 1, 2, 2, 2, 4 };
+    const std::vector<int> multiples = { 1, 2, 2, 4, 4 };
+    EXPECT_THAT(set_intersection(assume_sorted, stream_of(sorted), stream_of(multiples)).collect(to_vector()), ElementsAre(1, 2, 2, 4));
+    EXPECT_THAT(set_difference(assume_sorted, stream_of(sorted), stream_of(multiples)).collect(to_vector()), ElementsAre(1, 2));
+}
+
+TEST(TEST_CASE_NAME, merge_join_Test)
+{
+    const std::map<int, std::string> users = { { 1, "ann" }, { 2, "bob" }, { 4, "eve" } };
+    const std::vector<std::pair<int, int>> orders = { { 1, 10 }, { 1, 11 }, { 3, 30 }, { 4, 40 } };
+
+    const auto key = [](const auto& x) { return x.first; };
+
+    auto result = merge_join(assume_sorted, stream_of(users), stream_of(orders), key)
+        .map([](const auto& x) { return x.first.second + std::to_string(x.second.second); })
+        .collect(to_vector());
+
+    EXPECT_THAT(result, ElementsAre("ann10", "ann11", "eve40"));
+
+    const std::vector<int> left = { 1, 2, 2, 3 };
+    const std::vector<int> right = { 2, 2, 3, 5 };
+    const auto identity = [](auto x) { return x; };
+
+    EXPECT_THAT(merge_join(assume_sorted, stream_of(left), stream_of(right), identity).count(), Eq(5u));
+}
+
+TEST(TEST_CASE_NAME, hash_join_Test)
+{
+    const std::vector<std::pair<int, int>> orders = { { 1, 10 }, { 3, 30 }, { 1, 11 }, { 4, 40 } };
+    const std::map<int, std::string> users = { { 4, "eve" }, { 1, "ann" }, { 2, "bob" } };
+
+    const auto key = [](const auto& x) { return x.first; };
+
+    auto result = hash_join(stream_of(orders), stream_of(users), key, key)
+        .map([](const auto& x) { return x.second.second + std::to_string(x.first.second); })
+        .collect(to_vector());
+
+    EXPECT_THAT(result, ElementsAre("ann10", "ann11", "eve40"));
+
+    auto left = left_hash_join(stream_of(orders), stream_of(users), key, key)
+        .map([](const auto& x) { return x.second.non_empty() ? x.second.get().second : std::string("none"); })
+        .collect(to_vector());
+
+    EXPECT_THAT(left, ElementsAre("ann", "none", "ann", "eve"));
+
+    const auto identity = [](auto x) { return x; };
+    const std::vector<int> probe = { 3, 1, 2, 2, 5, 1 };
+    const std::vector<int> build = { 2, 1, 1 };
+
+    EXPECT_THAT(hash_join(stream_of(probe), stream_of(build), identity, identity).count(), Eq(6u));
+    EXPECT_THAT(semi_hash_join(stream_of(probe), stream_of(build), identity, identity).collect(to_vector()), ElementsAre(1, 2, 2, 1));
+    EXPECT_THAT(anti_hash_join(stream_of(probe), stream_of(build), identity, identity).collect(to_vector()), ElementsAre(3, 5));
+
+    auto pairs = left_hash_join(stream_of(probe), stream_of(build), identity, identity).collect(to_vector());
+    EXPECT_THAT(pairs.front(), Eq(std::make_pair(3, option<int>())));
+}
+
+TEST(TEST_CASE_NAME, hash_join_large_build_Test)
+{
+    std::vector<int> build(100000);
+    for (size_t i = 0; i < build.size(); ++i)
+        build[i] = static_cast<int>(i / 2);
+
+    const auto identity = [](auto x) { return x; };
+    const std::vector<int> probe = { -1, 0, 777, 49999, 50000 };
+
+    auto result = hash_join(stream_of(probe), stream_of(build), identity, identity)
+        .map([](const auto& x) { return x.second; })
+        .collect(to_vector());
+
+    EXPECT_THAT(result, ElementsAre(0, 0, 777, 777, 49999, 49999));
+    EXPECT_THAT(anti_hash_join(stream_of(probe), stream_of(build), identity, identity).collect(to_vector()), ElementsAre(-1, 50000));
+}
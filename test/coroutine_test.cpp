@@ -0,0 +1,119 @@
+#include "test.hpp"
+
+#include "config.hpp"
+
+#ifdef EXSTREAM_COROUTINES
+
+#include "coroutine.hpp"
+#include "collectors/vector_collector.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+using namespace exstream;
+using namespace testing;
+
+#define TEST_CASE_NAME CoroutineTest
+
+static generator<int> iota(const int count)
+{
+    for (int i = 0; i < count; ++i)
+        co_yield i;
+}
+
+static generator<std::string> words(int& produced)
+{
+    const std::string word = "word";
+    for (; produced < 3; ++produced)
+        co_yield word;
+}
+
+// NOTE: resumes the awaiting coroutine on a new thread, a stand-in for an asynchronous operation
+struct resume_on_new_thread final
+{
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(const std::coroutine_handle<> handle) const
+    {
+        std::thread([handle] { handle.resume(); }).detach();
+    }
+
+    void await_resume() const noexcept
+    {
+    }
+};
+
+static async_generator<int> delayed_iota(const int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        co_await resume_on_new_thread();
+        co_yield i;
+    }
+}
+
+static async_generator<int> failing()
+{
+    co_await resume_on_new_thread();
+    co_yield 1;
+    throw std::runtime_error("Producer failure");
+}
+
+TEST(TEST_CASE_NAME, generator_Test)
+{
+    auto result = stream_of(iota(10))
+        .filter([](auto x) { return x % 2 == 0; })
+        .map([](auto x) { return x * 10; })
+        .collect(to_vector());
+
+    EXPECT_THAT(result, ElementsAre(0, 20, 40, 60, 80));
+    EXPECT_THAT(stream_of(iota(0)).count(), Eq(0u));
+
+    int produced = 0;
+    auto source = words(produced);
+    auto iter = stream_of(source).get_iterator();
+    EXPECT_THAT(produced, Eq(0));
+    ASSERT_TRUE(iter.has_next());
+    EXPECT_THAT(iter.next(), Eq("word"));
+    EXPECT_THAT(produced, Eq(0));
+    ASSERT_TRUE(iter.has_next());
+    EXPECT_THAT(produced, Eq(1));
+}
+
+TEST(TEST_CASE_NAME, async_collect_Test)
+{
+    auto source = delayed_iota(5);
+    EXPECT_THAT(sync_wait(async_collect(source, to_vector())), ElementsAre(0, 1, 2, 3, 4));
+
+    auto empty = delayed_iota(0);
+    EXPECT_TRUE(sync_wait(async_collect(empty, to_vector())).empty());
+
+    auto broken = failing();
+    EXPECT_THROW(sync_wait(async_collect(broken, to_vector())), std::runtime_error);
+}
+
+TEST(TEST_CASE_NAME, async_foreach_Test)
+{
+    const auto caller = std::this_thread::get_id();
+    auto source = delayed_iota(100);
+
+    int sum = 0;
+    bool resumed = true;
+    sync_wait(async_foreach(source, [&](const int x)
+    {
+        sum += x;
+        resumed = resumed && std::this_thread::get_id() != caller;
+    }));
+
+    EXPECT_THAT(sum, Eq(4950));
+    EXPECT_TRUE(resumed);
+}
+
+#endif
@@ -0,0 +1,76 @@
+#include "test.hpp"
+
+#include "stream_of.hpp"
+#include "collectors/vector_collector.hpp"
+
+using namespace exstream;
+using namespace testing;
+
+#define TEST_CASE_NAME InstrumentationTest
+
+struct instrumented_value final
+{
+    int value;
+};
+
+static std::vector<instrumented_value> make_values()
+{
+    std::vector<instrumented_value> values;
+    for (int i = 0; i < 100; ++i)
+        values.push_back(instrumented_value{ i % 50 });
+
+    return values;
+}
+
+TEST(TEST_CASE_NAME, pipeline_stats_Test)
+{
+    const auto values = make_values();
+
+    auto result = stream_of(values)
+        .map([](const auto& x) { return x.value; })
+        .filter([](auto x) { return x % 10 == 0; })
+        .distinct()
+        .collect(to_vector());
+
+    EXPECT_THAT(result, UnorderedElementsAre(0, 10, 20, 30, 40));
+
+    const auto& stages = last_pipeline_stats().stages();
+    ASSERT_THAT(stages.size(), Eq(3u));
+
+    EXPECT_THAT(stages[0].name, StrEq("map"));
+    EXPECT_THAT(stages[0].elements_in, Eq(100u));
+    EXPECT_THAT(stages[0].elements_out, Eq(100u));
+    EXPECT_THAT(stages[0].allocations, Eq(0u));
+
+    EXPECT_THAT(stages[1].name, StrEq("filter"));
+    EXPECT_THAT(stages[1].elements_in, Eq(100u));
+    EXPECT_THAT(stages[1].elements_out, Eq(10u));
+    EXPECT_THAT(stages[1].pass_ratio(), DoubleEq(0.1));
+
+    EXPECT_THAT(stages[2].name, StrEq("distinct"));
+    EXPECT_THAT(stages[2].elements_in, Eq(10u));
+    EXPECT_THAT(stages[2].elements_out, Eq(5u));
+    EXPECT_THAT(stages[2].allocations, Gt(0u));
+}
+
+TEST(TEST_CASE_NAME, nested_pipeline_Test)
+{
+    const auto values = make_values();
+    size_t nestedCount = 0;
+
+    stream_of(values)
+        .filter([](const auto& x) { return x.value < 2; })
+        .foreach([&](const auto& x)
+        {
+            nestedCount += stream_of(make_values())
+                .filter([&](const auto& y) { return y.value == x.value; })
+                .count();
+        });
+
+    EXPECT_THAT(nestedCount, Eq(8u));
+
+    const auto& stages = last_pipeline_stats().stages();
+    ASSERT_THAT(stages.size(), Eq(1u));
+    EXPECT_THAT(stages[0].elements_in, Eq(100u));
+    EXPECT_THAT(stages[0].elements_out, Eq(4u));
+}
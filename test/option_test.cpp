@@ -2,6 +2,10 @@
 
 #include "option.hpp"
 
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <memory>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
 using namespace exstream;
 using namespace testing;
 
@@ -206,6 +210,75 @@ TEST(TEST_CASE_NAME, IteratorTest)
 #endif
 }
 
+struct port final
+{
+    uint32_t number;
+};
+
+namespace exstream {
+
+template <>
+struct option_traits<port>
+{
+    static constexpr bool has_sentinel = true;
+
+    static void set_empty(void* ptr) noexcept
+    {
+        static_cast<port*>(ptr)->number = UINT32_MAX;
+    }
+
+    static bool is_empty(const void* ptr) noexcept
+    {
+        return static_cast<const port*>(ptr)->number == UINT32_MAX;
+    }
+};
+
+} // exstream namespace
+
+TEST(TEST_CASE_NAME, niche_Test)
+{
+    EXPECT_THAT(sizeof(option<not_null<int*>>), Eq(sizeof(int*)));
+    EXPECT_THAT(sizeof(option<not_null<std::unique_ptr<int>>>), Gt(sizeof(int*)));
+    EXPECT_THAT(sizeof(option<not_null<std::shared_ptr<int>>>), Gt(sizeof(std::shared_ptr<int>)));
+    EXPECT_THAT(sizeof(option<bool>), Eq(sizeof(bool)));
+    EXPECT_THAT(sizeof(option<port>), Eq(sizeof(port)));
+
+    int number = 42;
+    option<not_null<int*>> pointer;
+    EXPECT_THAT(pointer, IsEmpty());
+
+    pointer.emplace(&number);
+    EXPECT_THAT(*pointer.get(), Eq(42));
+
+    auto copy = pointer;
+    pointer.reset();
+    EXPECT_THAT(pointer, IsEmpty());
+    EXPECT_THAT(copy.get().get(), Eq(&number));
+
+    option<bool> flag(false);
+    EXPECT_THAT(flag.non_empty(), IsTrue());
+    EXPECT_THAT(flag.get(), IsFalse());
+
+    flag = none();
+    EXPECT_THAT(flag, IsEmpty());
+
+    option<not_null<std::unique_ptr<int>>> owner(not_null<std::unique_ptr<int>>(std::make_unique<int>(1)));
+    auto moved = std::move(owner);
+    EXPECT_THAT(owner, IsEmpty());
+    EXPECT_THAT(*moved.get(), Eq(1));
+
+    option<port> id(port{ 80 });
+    EXPECT_THAT(id.get().number, Eq(80u));
+
+    id.reset();
+    EXPECT_THAT(id, IsEmpty());
+}
+
+static_assert(std::is_trivially_copyable_v<option<int>>, "option of a trivially copyable type should be trivially copyable");
+static_assert(std::is_trivially_copyable_v<option<complex_constructible>>, "option of a trivially copyable type should be trivially copyable");
+static_assert(std::is_trivially_copyable_v<option<not_null<int*>>>, "option of a trivially copyable type should be trivially copyable");
+static_assert(!std::is_trivially_copyable_v<option<std::unique_ptr<int>>>, "option of a non trivially copyable type can't be trivially copyable");
+
 TEST(TEST_CASE_NAME, CompilationTest)
 {
     non_movable value;
@@ -0,0 +1,103 @@
+#include "test.hpp"
+
+#include "small_vector.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <string>
+#include <vector>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+using namespace exstream;
+using namespace testing;
+
+#define TEST_CASE_NAME SmallVectorTest
+
+TEST(TEST_CASE_NAME, push_Test)
+{
+    std::vector<size_t> allocations;
+    small_vector<std::string, 2, tracking_allocator<std::string>> vector{ tracking_allocator<std::string>(allocations) };
+
+    vector.push_back("a");
+    vector.emplace_back(2, 'b');
+    EXPECT_TRUE(vector.is_inline());
+    EXPECT_THAT(allocations, IsEmpty());
+
+    vector.push_back(vector.front());
+    EXPECT_FALSE(vector.is_inline());
+    EXPECT_THAT(allocations, SizeIs(1u));
+    EXPECT_THAT(vector, ElementsAre("a", "bb", "a"));
+
+    vector.pop_back();
+    EXPECT_THAT(vector, ElementsAre("a", "bb"));
+    EXPECT_THAT(vector.capacity(), Ge(3u));
+}
+
+TEST(TEST_CASE_NAME, reserve_Test)
+{
+    std::vector<size_t> allocations;
+    small_vector<int, 4, tracking_allocator<int>> vector{ tracking_allocator<int>(allocations) };
+
+    vector.reserve(4);
+    EXPECT_TRUE(vector.is_inline());
+    EXPECT_THAT(allocations, IsEmpty());
+
+    vector.reserve(7);
+    EXPECT_THAT(vector.capacity(), Eq(7u));
+    EXPECT_THAT(allocations, SizeIs(1u));
+
+    for (int i = 0; i < 7; ++i)
+        vector.push_back(i);
+
+    EXPECT_THAT(allocations, SizeIs(1u));
+    EXPECT_THAT(vector, ElementsAre(0, 1, 2, 3, 4, 5, 6));
+
+    const int tail[] = { 7, 8, 9 };
+    vector.append(std::begin(tail), std::end(tail));
+    EXPECT_THAT(allocations, SizeIs(2u));
+    EXPECT_THAT(vector.capacity(), Eq(14u));
+    EXPECT_THAT(vector, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+TEST(TEST_CASE_NAME, copy_Test)
+{
+    const small_vector<std::string, 2> small = { "a", "b" };
+    const small_vector<std::string, 2> large = { "a", "b", "c" };
+
+    auto smallCopy = small;
+    auto largeCopy = large;
+    EXPECT_THAT(smallCopy, Eq(small));
+    EXPECT_THAT(largeCopy, Eq(large));
+
+    auto smallMoved = std::move(smallCopy);
+    auto largeMoved = std::move(largeCopy);
+    EXPECT_TRUE(smallMoved.is_inline());
+    EXPECT_FALSE(largeMoved.is_inline());
+    EXPECT_THAT(smallMoved, ElementsAre("a", "b"));
+    EXPECT_THAT(largeMoved, ElementsAre("a", "b", "c"));
+    EXPECT_TRUE(largeCopy.empty());
+    EXPECT_TRUE(largeCopy.is_inline());
+
+    smallMoved = std::move(largeMoved);
+    EXPECT_THAT(smallMoved, ElementsAre("a", "b", "c"));
+
+    largeMoved = small;
+    EXPECT_THAT(largeMoved, ElementsAre("a", "b"));
+}
+
+TEST(TEST_CASE_NAME, destruction_Test)
+{
+    const auto counter = std::make_shared<int>(0);
+    {
+        small_vector<std::shared_ptr<int>, 2> vector;
+        for (int i = 0; i < 5; ++i)
+            vector.push_back(counter);
+
+        EXPECT_THAT(counter.use_count(), Eq(6));
+        vector.clear();
+        EXPECT_THAT(counter.use_count(), Eq(1));
+
+        vector.push_back(counter);
+    }
+
+    EXPECT_THAT(counter.use_count(), Eq(1));
+}
@@ -0,0 +1,73 @@
+#include "test.hpp"
+
+#include "static_vector.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <memory>
+#include <string>
+EXSTREAM_RESTORE_ALL_WARNINGS
+
+using namespace exstream;
+using namespace testing;
+
+#define TEST_CASE_NAME StaticVectorTest
+
+TEST(TEST_CASE_NAME, push_Test)
+{
+    static_vector<std::string, 3> vector;
+    EXPECT_TRUE(vector.empty());
+    EXPECT_THAT(vector.capacity(), Eq(3u));
+
+    vector.push_back("a");
+    vector.emplace_back(2, 'b');
+    vector.push_back(std::string("c"));
+
+    EXPECT_TRUE(vector.full());
+    EXPECT_THAT(vector, ElementsAre("a", "bb", "c"));
+    EXPECT_THAT(vector.front(), Eq("a"));
+    EXPECT_THAT(vector.back(), Eq("c"));
+
+    vector.pop_back();
+    EXPECT_THAT(vector, ElementsAre("a", "bb"));
+
+#ifdef EXSTREAM_DEBUG
+    vector.push_back("c");
+    EXPECT_ANY_DEATH(vector.push_back("d"));
+#endif
+}
+
+TEST(TEST_CASE_NAME, copy_Test)
+{
+    const static_vector<std::string, 4> source = { "a", "b", "c" };
+
+    auto copy = source;
+    EXPECT_THAT(copy, Eq(source));
+
+    auto moved = std::move(copy);
+    EXPECT_THAT(moved, ElementsAre("a", "b", "c"));
+
+    static_vector<std::string, 4> assigned = { "x" };
+    assigned = source;
+    EXPECT_THAT(assigned, ElementsAre("a", "b", "c"));
+
+    assigned = static_vector<std::string, 4>({ "y" });
+    EXPECT_THAT(assigned, ElementsAre("y"));
+}
+
+TEST(TEST_CASE_NAME, destruction_Test)
+{
+    const auto counter = std::make_shared<int>(0);
+    {
+        static_vector<std::shared_ptr<int>, 8> vector;
+        for (int i = 0; i < 5; ++i)
+            vector.push_back(counter);
+
+        EXPECT_THAT(counter.use_count(), Eq(6));
+        vector.clear();
+        EXPECT_THAT(counter.use_count(), Eq(1));
+
+        vector.push_back(counter);
+    }
+
+    EXPECT_THAT(counter.use_count(), Eq(1));
+}
@@ -1,6 +1,7 @@
 #include "test.hpp"
 
 #include "stream_of.hpp"
+#include "stream_of_columns.hpp"
 #include "make_array.hpp"
 #include "collectors/collectors.hpp"
 
@@ -9,6 +10,9 @@ EXSTREAM_SUPPRESS_ALL_WARNINGS
 #include <deque>
 #include <queue>
 #include <stack>
+#include <string>
+#include <thread>
+#include <vector>
 EXSTREAM_RESTORE_ALL_WARNINGS
 
 using namespace exstream;
@@ -44,6 +48,37 @@ TEST(TEST_CASE_NAME, fill_Test)
     EXPECT_THAT(set, ElementsAre(0, 2, 4, 9, 10));
 }
 
+TEST(TEST_CASE_NAME, bulk_fill_Test)
+{
+    std::vector<int> vector = { 1 };
+
+    stream_of(test_values).fill(std::back_inserter(vector));
+    EXPECT_THAT(vector, ElementsAre(1, 4, 10, 2, 9, 4, 0));
+
+    std::deque<int> deque;
+
+    stream_of(std::vector<int>(std::begin(test_values), std::end(test_values))).fill(std::back_inserter(deque));
+    EXPECT_THAT(deque, ElementsAreArray(test_values));
+}
+
+TEST(TEST_CASE_NAME, fill_n_Test)
+{
+    std::vector<int> vector(test_values.size());
+
+    const auto end = stream_of(test_values).fill_n(std::begin(vector));
+    EXPECT_THAT(end, Eq(std::end(vector)));
+    EXPECT_THAT(vector, ElementsAreArray(test_values));
+
+    int array[3] = {};
+
+    const auto* arrayEnd = stream_of(test_values)
+        .filter([](auto x) { return x > 4; })
+        .fill_n(std::begin(array));
+
+    EXPECT_THAT(arrayEnd, Eq(std::begin(array) + 2));
+    EXPECT_THAT(array, ElementsAre(10, 9, 0));
+}
+
 TEST(TEST_CASE_NAME, foreach_Test)
 {
     std::vector<int> values;
@@ -211,6 +246,262 @@ TEST(TEST_CASE_NAME, collectors_Test)
     }
 }
 
+TEST(TEST_CASE_NAME, bulk_collect_Test)
+{
+    std::vector<int> source(std::begin(test_values), std::end(test_values));
+
+    EXPECT_THAT(stream_of(source).collect(to_vector()), ElementsAreArray(test_values));
+    EXPECT_THAT(stream_of(std::move(source)).collect(to_deque()), ElementsAreArray(test_values));
+    EXPECT_THAT(stream_of(test_values).collect(to_vector(std::vector<int>{ 1 })), ElementsAre(1, 4, 10, 2, 9, 4, 0));
+}
+
+TEST(TEST_CASE_NAME, concurrent_collectors_Test)
+{
+    EXPECT_THAT(stream_of(test_values).collect(to_concurrent_unordered_set(4)), UnorderedElementsAre(0, 2, 4, 9, 10));
+    EXPECT_THAT(stream_of(test_values).collect(to_concurrent_unordered_multiset()), UnorderedElementsAreArray(test_values));
+
+    const auto entries = stream_of(test_values)
+        .map([](auto x) { return std::make_tuple(x, std::to_string(x)); })
+        .collect(to_concurrent_unordered_map());
+
+    EXPECT_THAT(entries.size(), Eq(5u));
+    EXPECT_THAT(entries.at(9), Eq("9"));
+
+    const auto sharded = stream_of(test_values).collect(to_sharded_unordered_set(8));
+    EXPECT_THAT(sharded.shard_count(), Eq(8u));
+    EXPECT_THAT(sharded.size(), Eq(5u));
+    EXPECT_THAT(sharded.count(4), Eq(1u));
+    EXPECT_THAT(sharded.count(5), Eq(0u));
+
+    constexpr int threads = 4;
+    constexpr int perThread = 10000;
+
+    auto builder = to_sharded_unordered_map(16).builder(type_t<std::pair<int, int>>());
+    builder.reserve(threads * perThread);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&builder, t]
+        {
+            for (int i = 0; i < perThread; ++i)
+                builder.append(std::make_pair(i * threads + t, t));
+        });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    auto map = builder.build();
+    EXPECT_THAT(map.size(), Eq(size_t(threads * perThread)));
+    for (const auto& shard : map)
+    {
+        for (const auto& entry : shard)
+            EXPECT_THAT(&map.shard_of(entry.first), Eq(&shard));
+    }
+
+    const auto merged = std::move(map).merge();
+    EXPECT_THAT(merged.size(), Eq(size_t(threads * perThread)));
+    EXPECT_THAT(merged.at(4 * threads + 3), Eq(3));
+}
+
+template <typename Collector, typename T>
+static auto combine_chunks(Collector&& collector, const std::vector<std::vector<T>>& chunks)
+{
+    auto builder = collector.builder(type_t<T>());
+    for (const auto& chunk : chunks)
+    {
+        auto next = collector.builder(type_t<T>());
+        for (const auto& value : chunk)
+            next.append(value);
+
+        builder.combine(std::move(next));
+    }
+
+    return builder.build();
+}
+
+TEST(TEST_CASE_NAME, combine_Test)
+{
+    const std::vector<std::vector<int>> chunks = { { 4, 10 }, {}, { 2, 9, 4 }, { 0 } };
+
+    EXPECT_THAT(combine_chunks(to_vector(), chunks), ElementsAreArray(test_values));
+    EXPECT_THAT(combine_chunks(to_deque(), chunks), ElementsAreArray(test_values));
+    EXPECT_THAT(combine_chunks(to_list(), chunks), ElementsAreArray(test_values));
+    EXPECT_THAT(combine_chunks(to_forward_list(), chunks), ElementsAreArray(test_values));
+    EXPECT_THAT(combine_chunks(to_multiset(), chunks), ElementsAre(0, 2, 4, 4, 9, 10));
+    EXPECT_THAT(combine_chunks(to_unordered_set(), chunks), UnorderedElementsAre(0, 2, 4, 9, 10));
+    EXPECT_THAT(combine_chunks(to_concurrent_unordered_multiset(2), chunks), UnorderedElementsAreArray(test_values));
+    EXPECT_THAT(combine_chunks(to_stack(), chunks).top(), Eq(0));
+    EXPECT_THAT(combine_chunks(to_queue(), chunks).front(), Eq(4));
+    EXPECT_THAT(combine_chunks(to_priority_queue(), chunks).top(), Eq(10));
+
+    auto queue = combine_chunks(to_queue(std::queue<int>(std::deque<int>{ 1 })), chunks);
+    EXPECT_THAT(queue.size(), Eq(7u));
+    EXPECT_THAT(queue.front(), Eq(1));
+    EXPECT_THAT(queue.back(), Eq(0));
+
+    const auto minimum = combine_chunks(to_priority_queue(std::priority_queue<int, std::vector<int>, std::greater<int>>()), chunks);
+    EXPECT_THAT(minimum.size(), Eq(6u));
+    EXPECT_THAT(minimum.top(), Eq(0));
+
+    const std::vector<std::vector<std::pair<int, char>>> entries = { { { 1, 'a' }, { 2, 'b' } }, { { 2, 'c' }, { 3, 'd' } } };
+    EXPECT_THAT(combine_chunks(to_map(), entries), ElementsAre(Pair(1, 'a'), Pair(2, 'b'), Pair(3, 'd')));
+    EXPECT_THAT(combine_chunks(to_unordered_map(), entries), UnorderedElementsAre(Pair(1, 'a'), Pair(2, 'b'), Pair(3, 'd')));
+
+    const auto columns = combine_chunks(to_columns(), entries);
+    EXPECT_THAT(std::get<0>(columns), ElementsAre(1, 2, 2, 3));
+    EXPECT_THAT(std::get<1>(columns), ElementsAre('a', 'b', 'c', 'd'));
+}
+
+TEST(TEST_CASE_NAME, combine_range_Test)
+{
+    using builder_t = decltype(to_vector().builder(type_t<std::string>()));
+
+    std::vector<builder_t> builders;
+    for (int chunk = 0; chunk < 8; ++chunk)
+    {
+        builders.push_back(to_vector().builder(type_t<std::string>()));
+        for (int i = 0; i < 20000; ++i)
+            builders.back().append(std::to_string(chunk * 20000 + i));
+    }
+
+    auto builder = to_vector(std::vector<std::string>{ "first" }).builder(type_t<std::string>());
+    builder.combine(builders.begin(), builders.end());
+
+    const auto result = builder.build();
+    ASSERT_THAT(result.size(), Eq(160001u));
+    EXPECT_THAT(result.front(), Eq("first"));
+    for (size_t i = 1; i < result.size(); ++i)
+        ASSERT_THAT(result[i], Eq(std::to_string(i - 1)));
+
+    auto chunks = std::vector<decltype(to_list().builder(type_t<int>()))>(3);
+    chunks[0].append(1);
+    chunks[2].append(2);
+
+    auto list = to_list().builder(type_t<int>());
+    list.combine(chunks.begin(), chunks.end());
+    EXPECT_THAT(list.build(), ElementsAre(1, 2));
+}
+
+TEST(TEST_CASE_NAME, columns_Test)
+{
+    const std::vector<std::tuple<int, char>> records = { { 1, 'a' }, { 2, 'b' }, { 3, 'c' } };
+
+    const auto columns = stream_of(records).collect(to_columns());
+    EXPECT_THAT(std::get<0>(columns), ElementsAre(1, 2, 3));
+    EXPECT_THAT(std::get<1>(columns), ElementsAre('a', 'b', 'c'));
+
+    auto keys = stream_of_columns(columns)
+        .map([](const auto& row) { return std::get<0>(row) * 2; })
+        .collect(to_vector());
+
+    EXPECT_THAT(keys, ElementsAre(2, 4, 6));
+    EXPECT_THAT(stream_of_columns(columns).collect(to_vector()), ElementsAreArray(records));
+
+    const std::vector<int> ids = { 7, 8 };
+    const auto pairs = stream_of_columns(ids, std::get<1>(columns))
+        .map([](const auto& row) { return std::make_pair(std::get<0>(row), std::get<1>(row)); })
+        .collect(to_columns());
+
+    EXPECT_THAT(std::get<0>(pairs), ElementsAre(7, 8));
+    EXPECT_THAT(std::get<1>(pairs), ElementsAre('a', 'b'));
+}
+
+TEST(TEST_CASE_NAME, static_vector_collector_Test)
+{
+    const auto result = stream_of(test_values).collect(to_static_vector<8>());
+    EXPECT_THAT(result, ElementsAre(4, 10, 2, 9, 4, 0));
+
+    const auto filtered = stream_of(test_values)
+        .filter([](auto x) { return x > 3; })
+        .collect(static_vector_collector<4>());
+
+    EXPECT_THAT(filtered, ElementsAre(4, 10, 9, 4));
+
+    const auto truncated = stream_of(test_values)
+        .filter([](auto x) { return x != 10; })
+        .collect(to_static_vector<3>(Overflow::Truncate));
+
+    EXPECT_THAT(truncated, ElementsAre(4, 2, 9));
+
+    EXPECT_THROW(stream_of(test_values).collect(to_static_vector<5>()), capacity_overflow);
+    EXPECT_THROW(stream_of(test_values).filter([](auto) { return true; }).collect(to_static_vector<5>()), capacity_overflow);
+}
+
+TEST(TEST_CASE_NAME, array_collector_Test)
+{
+    const auto result = stream_of(test_values).collect(to_array<6>());
+    EXPECT_THAT(result, ElementsAre(4, 10, 2, 9, 4, 0));
+
+    const auto padded = stream_of(test_values)
+        .filter([](auto x) { return x > 3; })
+        .collect(array_collector<6>());
+
+    EXPECT_THAT(padded, ElementsAre(4, 10, 9, 4, 0, 0));
+
+    const auto truncated = stream_of(test_values).collect(to_array<2>(Overflow::Truncate));
+    EXPECT_THAT(truncated, ElementsAre(4, 10));
+
+    size_t consumed = 0;
+    EXPECT_THROW(stream_of(test_values).map([&](auto x) { ++consumed; return x; }).collect(to_array<3>()), capacity_overflow);
+    EXPECT_THAT(consumed, Eq(0u));
+}
+
+TEST(TEST_CASE_NAME, small_vector_collector_Test)
+{
+    std::vector<size_t> allocations;
+    const tracking_allocator<unsigned char> alloc(allocations);
+
+    const auto small = stream_of(test_values, alloc)
+        .filter([](auto x) { return x > 3; })
+        .collect(to_small_vector<4>());
+
+    EXPECT_THAT(small, ElementsAre(4, 10, 9, 4));
+    EXPECT_TRUE(small.is_inline());
+    EXPECT_THAT(allocations, IsEmpty());
+
+    const auto exact = stream_of(test_values, alloc).collect(to_small_vector<4>());
+    EXPECT_THAT(exact, ElementsAre(4, 10, 2, 9, 4, 0));
+    EXPECT_THAT(exact.capacity(), Eq(6u));
+    EXPECT_THAT(allocations, ElementsAre(6u));
+
+    allocations.clear();
+    const auto grown = stream_of(test_values, alloc)
+        .filter([](auto) { return true; })
+        .collect(small_vector_collector<4>());
+
+    EXPECT_THAT(grown, ElementsAre(4, 10, 2, 9, 4, 0));
+    EXPECT_THAT(allocations, ElementsAre(8u));
+
+    const auto defaulted = stream_of(test_values).collect(to_small_vector<8>());
+    EXPECT_THAT(defaulted, ElementsAre(4, 10, 2, 9, 4, 0));
+}
+
+TEST(TEST_CASE_NAME, approx_distinct_count_Test)
+{
+    std::vector<int> values;
+    for (int i = 0; i < 100000; ++i)
+        values.push_back(i % 20000);
+
+    EXPECT_THAT(stream_of(values).approx_distinct_count(), AllOf(Ge(19000u), Le(21000u)));
+    EXPECT_THAT(stream_of(make_array(1, 2, 2, 3)).approx_distinct_count(), Eq(3u));
+    EXPECT_THAT(stream_of(std::vector<int>()).approx_distinct_count(), Eq(0u));
+}
+
+TEST(TEST_CASE_NAME, heavy_hitters_Test)
+{
+    const auto hitters = stream_of(make_array(1, 2, 1, 3, 1, 2, 4))
+        .heavy_hitters(4);
+
+    ASSERT_THAT(hitters.size(), Eq(4u));
+    EXPECT_THAT(hitters[0].value, Eq(1));
+    EXPECT_THAT(hitters[0].count, Eq(3u));
+    EXPECT_THAT(hitters[0].error, Eq(0u));
+    EXPECT_THAT(hitters[1].value, Eq(2));
+    EXPECT_THAT(hitters[1].count, Eq(2u));
+}
+
 TEST(TEST_CASE_NAME, collectors_with_arg_Test)
 {
     // TODO:
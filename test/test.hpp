@@ -6,6 +6,8 @@
 EXSTREAM_SUPPRESS_ALL_WARNINGS
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <memory>
+#include <vector>
 EXSTREAM_RESTORE_ALL_WARNINGS
 
 #define EXPECT_TYPES_EQ(T1, T2)\
@@ -74,4 +76,47 @@ is_types_ne(const char*, const char*, const char*, const char*,
                                        << ySource << " = " << y;
 }
 
+// NOTE: records the size of every allocation, the copies share the records
+template <typename T>
+struct tracking_allocator final
+{
+    using value_type = T;
+
+    explicit tracking_allocator(std::vector<size_t>& allocations) noexcept
+        : allocations(&allocations)
+    {
+    }
+
+    template <typename U>
+    tracking_allocator(const tracking_allocator<U>& that) noexcept
+        : allocations(that.allocations)
+    {
+    }
+
+    T* allocate(const size_t count)
+    {
+        allocations->push_back(count);
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T* ptr, const size_t count) noexcept
+    {
+        std::allocator<T>().deallocate(ptr, count);
+    }
+
+    template <typename U>
+    bool operator== (const tracking_allocator<U>& that) const noexcept
+    {
+        return allocations == that.allocations;
+    }
+
+    template <typename U>
+    bool operator!= (const tracking_allocator<U>& that) const noexcept
+    {
+        return allocations != that.allocations;
+    }
+
+    std::vector<size_t>* allocations;
+};
+
 } // exstream namespace
@@ -2,7 +2,13 @@
 
 #include "stream_of.hpp"
 #include "make_array.hpp"
+#include "variant.hpp"
 #include "collectors/vector_collector.hpp"
+#include "aggregators/running_stats.hpp"
+
+EXSTREAM_SUPPRESS_ALL_WARNINGS
+#include <memory>
+EXSTREAM_RESTORE_ALL_WARNINGS
 
 using namespace exstream;
 using namespace testing;
@@ -11,6 +17,88 @@ using namespace testing;
 
 static const auto test_values = make_array(0, 3, 4, 0, 1, 5, 5, 4);
 
+struct copy_counter final
+{
+    explicit copy_counter(const int value) noexcept
+        : value(value)
+    {
+    }
+
+    copy_counter(const copy_counter& that) noexcept
+        : value(that.value)
+    {
+        ++copies;
+    }
+
+    copy_counter(copy_counter&&) = default;
+
+    bool operator== (const copy_counter& that) const noexcept
+    {
+        return value == that.value;
+    }
+
+    bool operator!= (const copy_counter& that) const noexcept
+    {
+        return value != that.value;
+    }
+
+    int value;
+    static size_t copies;
+};
+
+size_t copy_counter::copies = 0;
+
+struct move_only_key final
+{
+    explicit move_only_key(const int value)
+        : value(std::make_unique<int>(value))
+    {
+    }
+
+    bool operator== (const move_only_key& that) const noexcept
+    {
+        return *value == *that.value;
+    }
+
+    bool operator!= (const move_only_key& that) const noexcept
+    {
+        return *value != *that.value;
+    }
+
+    std::unique_ptr<int> value;
+};
+
+namespace std {
+
+template <>
+struct hash<copy_counter>
+{
+    size_t operator() (const copy_counter& counter) const noexcept
+    {
+        return std::hash<int>()(counter.value);
+    }
+};
+
+template <>
+struct hash<move_only_key>
+{
+    size_t operator() (const move_only_key& key) const noexcept
+    {
+        return std::hash<int>()(*key.value);
+    }
+};
+
+} // std namespace
+
+static std::vector<copy_counter> make_counters()
+{
+    std::vector<copy_counter> counters;
+    for (const auto value : test_values)
+        counters.emplace_back(value);
+
+    return counters;
+}
+
 TEST(TEST_CASE_NAME, distinct_Test)
 {
     auto result = stream_of(test_values)
@@ -20,6 +108,85 @@ TEST(TEST_CASE_NAME, distinct_Test)
     EXPECT_THAT(result, UnorderedElementsAre(0, 3, 4, 1, 5));
 }
 
+TEST(TEST_CASE_NAME, distinct_zero_copy_Test)
+{
+    auto counters = make_counters();
+    int sum = 0;
+
+    copy_counter::copies = 0;
+    stream_of(counters)
+        .filter([](const auto& x) { return x.value > 0; })
+        .distinct()
+        .foreach([&](const auto& x) { sum += x.value; });
+
+    EXPECT_THAT(sum, Eq(13));
+    EXPECT_THAT(copy_counter::copies, Eq(0u));
+
+    sum = 0;
+    stream_of(std::move(counters))
+        .distinct()
+        .foreach([&](const auto& x) { sum += x.value; });
+
+    EXPECT_THAT(sum, Eq(13));
+    EXPECT_THAT(copy_counter::copies, Eq(0u));
+}
+
+TEST(TEST_CASE_NAME, distinct_move_only_Test)
+{
+    const auto result = stream_of(test_values)
+        .map([](auto x) { return move_only_key(x); })
+        .distinct()
+        .map([](const auto& key) { return *key.value; })
+        .collect(to_vector());
+
+    EXPECT_THAT(result, ElementsAre(0, 3, 4, 1, 5));
+}
+
+TEST(TEST_CASE_NAME, bloom_distinct_Test)
+{
+    auto result = stream_of(test_values)
+        .bloom_distinct()
+        .collect(to_vector());
+
+    EXPECT_THAT(result, ElementsAre(0, 3, 4, 1, 5));
+
+    std::vector<int> values;
+    for (int i = 0; i < 20000; ++i)
+        values.push_back(i % 10000);
+
+    const auto count = stream_of(values)
+        .filter([](auto) { return true; })
+        .bloom_distinct(0.01, 10000)
+        .count();
+
+    EXPECT_THAT(count, AllOf(Le(10000u), Ge(9800u)));
+
+    using meta = decltype(stream_of(test_values).bloom_distinct())::meta;
+    EXPECT_TRUE(meta::is_distinct);
+}
+
+TEST(TEST_CASE_NAME, enumerate_Test)
+{
+    auto result = stream_of(test_values)
+        .filter([](auto x) { return x > 3; })
+        .enumerate()
+        .collect(to_vector());
+
+    EXPECT_THAT(result, ElementsAre(Pair(0u, 4), Pair(1u, 5), Pair(2u, 5), Pair(3u, 4)));
+
+    size_t indexSum = 0;
+    stream_of(test_values)
+        .flat_map_into<int>([](auto x, auto& emit) { emit(x); })
+        .enumerate()
+        .foreach([&](const auto& x) { indexSum += x.first; });
+
+    EXPECT_THAT(indexSum, Eq(28u));
+
+    using meta = decltype(stream_of(test_values).enumerate())::meta;
+    EXPECT_TRUE(meta::is_ordered);
+    EXPECT_TRUE(meta::is_distinct);
+}
+
 TEST(TEST_CASE_NAME, filter_Test)
 {
     auto result = stream_of(test_values)
@@ -29,6 +196,69 @@ TEST(TEST_CASE_NAME, filter_Test)
     EXPECT_THAT(result, UnorderedElementsAre(3, 4, 5, 5, 4));
 }
 
+TEST(TEST_CASE_NAME, filter_map_Test)
+{
+    const auto halfOfEven = [](auto x)
+    {
+        return (x % 2 == 0) ? option<int>(x / 2) : option<int>();
+    };
+
+    auto result = stream_of(test_values)
+        .filter_map(halfOfEven)
+        .collect(to_vector());
+
+    EXPECT_THAT(result, ElementsAre(0, 2, 0, 2));
+
+    auto filtered = stream_of(test_values)
+        .filter_map(halfOfEven)
+        .filter([](auto x) { return x > 0; })
+        .collect(to_vector());
+
+    EXPECT_THAT(filtered, ElementsAre(2, 2));
+}
+
+TEST(TEST_CASE_NAME, flatten_Test)
+{
+    const std::vector<option<int>> options = { option<int>(1), option<int>(), option<int>(3), option<int>() };
+
+    auto result = stream_of(options)
+        .flatten()
+        .collect(to_vector());
+
+    EXPECT_THAT(result, ElementsAre(1, 3));
+
+    auto counters = make_counters();
+    int sum = 0;
+
+    copy_counter::copies = 0;
+    stream_of(counters)
+        .map([](const auto& x) { return x.value > 3 ? someRef(x) : option<const copy_counter&>(); })
+        .flatten()
+        .foreach([&](const auto& x) { sum += x.value; });
+
+    EXPECT_THAT(sum, Eq(18));
+    EXPECT_THAT(copy_counter::copies, Eq(0u));
+}
+
+TEST(TEST_CASE_NAME, collect_variants_Test)
+{
+    using value_t = variant<int, std::string>;
+    const std::vector<value_t> values = { value_t(1), value_t(std::string("a")), value_t(2), value_t(std::string("b")) };
+
+    auto numbers = stream_of(values)
+        .collect_variants<int>()
+        .collect(to_vector());
+
+    EXPECT_THAT(numbers, ElementsAre(1, 2));
+
+    auto strings = stream_of(values)
+        .map([](const auto& x) { return x; })
+        .collect_variants<std::string>()
+        .collect(to_vector());
+
+    EXPECT_THAT(strings, ElementsAre("a", "b"));
+}
+
 TEST(TEST_CASE_NAME, flat_map_Test)
 {
     auto result = stream_of(test_values)
@@ -39,6 +269,52 @@ TEST(TEST_CASE_NAME, flat_map_Test)
     EXPECT_THAT(result, UnorderedElementsAreArray(expected));
 }
 
+TEST(TEST_CASE_NAME, flat_map_into_Test)
+{
+    const auto emitPair = [](auto x, auto& emit)
+    {
+        emit(1);
+        emit(x);
+    };
+
+    auto result = stream_of(test_values)
+        .flat_map_into<int>(emitPair)
+        .collect(to_vector());
+
+    const auto expected = make_array(1, 0, 1, 3, 1, 4, 1, 0, 1, 1, 1, 5, 1, 5, 1, 4);
+    EXPECT_THAT(result, ElementsAreArray(expected));
+
+    auto filtered = stream_of(test_values)
+        .flat_map_into<int>(emitPair)
+        .filter([](auto x) { return x > 1; })
+        .collect(to_vector());
+
+    EXPECT_THAT(filtered, ElementsAre(3, 4, 5, 5, 4));
+}
+
+TEST(TEST_CASE_NAME, flat_map_into_emitter_Test)
+{
+    // NOTE: the function takes the emitter type itself, so it has to be the same in the pull and in the push mode
+    const auto emitTwice = [](int x, detail::flat_map::emitter<int>& emit)
+    {
+        emit(x);
+        emit(x);
+    };
+
+    auto pushed = stream_of(test_values)
+        .flat_map_into<int>(emitTwice)
+        .collect(to_vector());
+
+    EXPECT_THAT(pushed, ElementsAre(0, 0, 3, 3, 4, 4, 0, 0, 1, 1, 5, 5, 5, 5, 4, 4));
+
+    auto pulled = stream_of(test_values)
+        .flat_map_into<int>(emitTwice)
+        .filter([](auto x) { return x > 3; })
+        .collect(to_vector());
+
+    EXPECT_THAT(pulled, ElementsAre(4, 4, 5, 5, 5, 5, 4, 4));
+}
+
 TEST(TEST_CASE_NAME, map_Test)
 {
     auto result = stream_of(test_values)
@@ -47,3 +323,116 @@ TEST(TEST_CASE_NAME, map_Test)
 
     EXPECT_THAT(result, ElementsAre(2, 5, 6, 2, 3, 7, 7, 6));
 }
+
+TEST(TEST_CASE_NAME, scan_Test)
+{
+    auto result = stream_of(test_values)
+        .scan(0, [](int sum, auto x) { return sum + x; })
+        .collect(to_vector());
+
+    EXPECT_THAT(result, ElementsAre(0, 3, 7, 7, 8, 13, 18, 22));
+    EXPECT_THAT(stream_of(test_values).scan(0, [](int sum, auto x) { return sum + x; }).count(), Eq(8u));
+
+    auto skipped = stream_of(test_values)
+        .scan(std::vector<int>(), [](std::vector<int> prefix, auto x)
+        {
+            prefix.push_back(x);
+            return prefix;
+        })
+        .filter([](const auto& prefix) { return prefix.size() % 4 == 0; })
+        .map([](const auto& prefix) { return prefix.back() * 10 + int(prefix.size()); })
+        .collect(to_vector());
+
+    EXPECT_THAT(skipped, ElementsAre(4, 48));
+}
+
+TEST(TEST_CASE_NAME, running_Test)
+{
+    auto means = stream_of(test_values)
+        .running(running_stats())
+        .map([](const running_stats& stats) { return stats.mean(); })
+        .collect(to_vector());
+
+    const auto expected = { 0.0, 1.5, 7.0 / 3, 7.0 / 4, 8.0 / 5, 13.0 / 6, 18.0 / 7, 22.0 / 8 };
+    ASSERT_THAT(means.size(), Eq(expected.size()));
+
+    for (size_t i = 0; i < means.size(); ++i)
+        EXPECT_THAT(means[i], DoubleNear(expected.begin()[i], 1e-12));
+
+    auto maximums = stream_of(test_values)
+        .running(running_stats())
+        .map([](const running_stats& stats) { return stats.max(); })
+        .collect(to_vector());
+
+    EXPECT_THAT(maximums, ElementsAre(0.0, 3.0, 4.0, 4.0, 4.0, 5.0, 5.0, 5.0));
+}
+
+static int sum_of(const window_view<detail::reference_storage<const int>>& window) noexcept
+{
+    int sum = 0;
+    for (const auto value : window)
+        sum += value;
+
+    return sum;
+}
+
+TEST(TEST_CASE_NAME, chunked_Test)
+{
+    auto result = stream_of(test_values)
+        .chunked(3)
+        .map([](const auto& chunk) { return sum_of(chunk); })
+        .collect(to_vector());
+
+    EXPECT_THAT(result, ElementsAre(7, 6, 9));
+    EXPECT_THAT(stream_of(test_values).chunked(3).count(), Eq(3u));
+    EXPECT_THAT(stream_of(test_values).chunked(4).count(), Eq(2u));
+    EXPECT_THAT(stream_of(test_values).filter([](auto x) { return x > 3; }).chunked(3).count(), Eq(2u));
+
+    auto mapped = stream_of(test_values)
+        .map([](auto x) { return x * 2; })
+        .chunked(5)
+        .map([](const auto& chunk) { return chunk.back(); })
+        .collect(to_vector());
+
+    EXPECT_THAT(mapped, ElementsAre(2, 8));
+}
+
+TEST(TEST_CASE_NAME, sliding_Test)
+{
+    auto result = stream_of(test_values)
+        .sliding(3)
+        .map([](const auto& window) { return sum_of(window); })
+        .collect(to_vector());
+
+    EXPECT_THAT(result, ElementsAre(7, 7, 5, 6, 11, 14));
+
+    auto stepped = stream_of(test_values)
+        .sliding(3, 2)
+        .map([](const auto& window) { return window.front() * 10 + window.size(); })
+        .collect(to_vector());
+
+    EXPECT_THAT(stepped, ElementsAre(3, 43, 13));
+
+    auto sparse = stream_of(test_values)
+        .sliding(2, 3)
+        .map([](const auto& window) { return sum_of(window); })
+        .collect(to_vector());
+
+    EXPECT_THAT(sparse, ElementsAre(3, 1, 9));
+
+    EXPECT_THAT(stream_of(test_values).sliding(3).count(), Eq(6u));
+    EXPECT_THAT(stream_of(test_values).sliding(3, 2).count(), Eq(3u));
+    EXPECT_THAT(stream_of(test_values).sliding(2, 3).count(), Eq(3u));
+    EXPECT_THAT(stream_of(test_values).sliding(9).count(), Eq(0u));
+
+    const auto counters = make_counters();
+    copy_counter::copies = 0;
+
+    size_t windows = 0;
+    stream_of(counters)
+        .sliding(4)
+        .foreach([&](const auto& window) { windows += window.size(); });
+
+    EXPECT_THAT(windows, Eq(20u));
+    EXPECT_THAT(copy_counter::copies, Eq(0u));
+}
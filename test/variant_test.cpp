@@ -1,6 +1,7 @@
 #include "test.hpp"
 
 #include "variant.hpp"
+#include "not_null.hpp"
 
 using namespace exstream;
 using namespace testing;
@@ -99,6 +100,9 @@ TEST(TEST_CASE_NAME, AssignmentTest)
         value = str;
         EXPECT_THAT(value.get<std::string>(), Eq(str));
     }
+
+    EXPECT_TRUE((std::is_nothrow_move_assignable_v<variant<int, std::string>>));
+    EXPECT_FALSE((std::is_nothrow_copy_assignable_v<variant<int, std::string>>));
 }
 
 TEST(TEST_CASE_NAME, emplace_Test)
@@ -277,3 +281,129 @@ TEST(TEST_CASE_NAME, hash_Test)
     EXPECT_THAT(hash(var("str"s)), Eq(strHash("str"s)));
     EXPECT_THAT(hash(var(custom_type(0, 1.f))), Eq(customHash(custom_type(0, 1.f))));
 }
+
+TEST(TEST_CASE_NAME, multi_variant_match_Test)
+{
+    const var lhs(42);
+    var rhs("str"s);
+
+    auto result = match([](const auto& a, auto& b)
+    {
+        using a_type = std::decay_t<decltype(a)>;
+        using b_type = std::decay_t<decltype(b)>;
+        return std::make_pair(type_list_ops::index_of_v<type_list<int, std::string, custom_type>, a_type>,
+                              type_list_ops::index_of_v<type_list<int, std::string, custom_type>, b_type>);
+    }, lhs, rhs);
+
+    EXPECT_THAT(result, Eq(std::make_pair(size_t(0), size_t(1))));
+
+    auto moved = match([](auto&& value, auto&& that)
+    {
+        using that_type = std::decay_t<decltype(that)>;
+        EXSTREAM_UNUSED(value);
+
+        return constexpr_if<std::is_same_v<that_type, std::string>>()
+            .then([&](auto) { return std::string(std::move(that)); })
+            .else_([](auto) { return std::string(); })(nothing);
+    }, var(custom_type(0, 0.f)), std::move(rhs));
+
+    EXPECT_THAT(moved, Eq("str"s));
+
+    valueless_var valueless(throw_on_assign{});
+    EXPECT_THROW(valueless = throw_on_assign(), int);
+    EXPECT_THROW(match([](auto&&, auto&&) {}, lhs, valueless), bad_variant_access);
+}
+
+template <size_t Index>
+struct alternative final
+{
+    size_t value;
+};
+
+template <size_t... Indices>
+auto make_wide_variants(std::index_sequence<Indices...>)
+{
+    using wide_var = variant<alternative<Indices>...>;
+    return std::vector<wide_var>{ wide_var(alternative<Indices>{ Indices })... };
+}
+
+TEST(TEST_CASE_NAME, wide_variant_dispatch_Test)
+{
+    const auto values = make_wide_variants(std::make_index_sequence<40>());
+    auto copies = values;
+
+    for (size_t i = 0; i < copies.size(); ++i)
+    {
+        EXPECT_THAT(copies[i].index(), Eq(i));
+        EXPECT_THAT(copies[i].match([](const auto& value) { return value.value; }), Eq(i));
+    }
+
+    copies[3] = values[39];
+    EXPECT_THAT(copies[3].index(), Eq(39u));
+    EXPECT_THAT(match([](const auto& a, const auto& b) { return a.value * 100 + b.value; }, copies[3], values[7]), Eq(3907u));
+}
+
+TEST(TEST_CASE_NAME, compact_index_Test)
+{
+    EXPECT_THAT(sizeof(variant<int32_t, float>), Eq(2 * sizeof(int32_t)));
+    EXPECT_THAT(sizeof(variant<char, bool>), Eq(2u));
+
+    valueless_var value(throw_on_assign{});
+    EXPECT_THROW(value = throw_on_assign(), int);
+    EXPECT_THAT(value.index(), Eq(variant_npos));
+}
+
+struct end_of_stream final {};
+
+TEST(TEST_CASE_NAME, niche_Test)
+{
+    using niche_var = variant<end_of_stream, not_null<int*>, throw_on_assign>;
+    EXPECT_THAT(sizeof(niche_var), Eq(sizeof(int*)));
+
+    int x = 42;
+    niche_var value{ not_null<int*>(&x) };
+    EXPECT_THAT(value.index(), Eq(1u));
+    EXPECT_THAT(*value.get<not_null<int*>>(), Eq(42));
+
+    niche_var that(end_of_stream{});
+    EXPECT_THAT(that.index(), Eq(0u));
+
+    swap(value, that);
+    EXPECT_THAT(value.contains<end_of_stream>(), IsTrue());
+    EXPECT_THAT(that.get<not_null<int*>>().get(), Eq(&x));
+
+    value = that;
+    EXPECT_THAT(value.get<not_null<int*>>().get(), Eq(&x));
+
+    value.emplace(in_place_type_t<throw_on_assign>());
+    EXPECT_THAT(value.index(), Eq(2u));
+    EXPECT_THROW(value = throw_on_assign(), int);
+    EXPECT_THAT(value.is_valueless_by_exception(), IsTrue());
+
+    value = that;
+    EXPECT_THAT(value.index(), Eq(1u));
+}
+
+static_assert(std::is_trivially_copyable_v<variant<int, float>>, "variant of trivially copyable types should be trivially copyable");
+static_assert(std::is_trivially_copyable_v<variant<end_of_stream, not_null<int*>>>, "variant of trivially copyable types should be trivially copyable");
+static_assert(!std::is_trivially_copyable_v<var>, "variant of a non trivially copyable type can't be trivially copyable");
+
+TEST(TEST_CASE_NAME, trivially_copyable_Test)
+{
+    using trivial_var = variant<int, float>;
+
+    std::vector<trivial_var> values;
+    for (int i = 0; i < 100; ++i)
+    {
+        if (i % 2 == 0) values.emplace_back(i);
+        else            values.emplace_back(float(i));
+    }
+
+    auto copies = values;
+    EXPECT_THAT(copies[42].get<int>(), Eq(42));
+    EXPECT_THAT(copies[43].get<float>(), Eq(43.f));
+
+    var value(42);
+    var that(value);
+    EXPECT_THAT(that.get<int>(), Eq(42));
+}